@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <map>
+#include <utility>
 
 namespace vca {
 
@@ -40,7 +41,7 @@ static const std::map<vca_colorSpace, vca_cli_csp> vca_cli_csps
 
 } // namespace
 
-FrameWithData::FrameWithData(const vca_frame_info &frameInfo)
+FrameWithData::FrameWithData(const vca_frame_info &frameInfo, bool allocateData)
 {
     this->vcaFrame.info = frameInfo;
 
@@ -55,11 +56,8 @@ FrameWithData::FrameWithData(const vca_frame_info &frameInfo)
         planeSizeBytes[i] = w * h * pixelbytes;
     }
 
-    const auto frameSizeBytes = planeSizeBytes[0] + planeSizeBytes[1] + planeSizeBytes[2];
-    if (this->data.size() < frameSizeBytes)
-        this->data.resize(frameSizeBytes);
+    this->frameSizeBytes = planeSizeBytes[0] + planeSizeBytes[1] + planeSizeBytes[2];
 
-    this->vcaFrame.planes[0] = this->data.data();
     this->vcaFrame.stride[0] = frameInfo.width * pixelbytes;
     this->vcaFrame.height[0] = frameInfo.height;
 
@@ -68,13 +66,52 @@ FrameWithData::FrameWithData(const vca_frame_info &frameInfo)
         uint32_t widthChroma  = frameInfo.width >> vca_cli_csps.at(colorspace).width[1];
         uint32_t heightChroma = frameInfo.height >> vca_cli_csps.at(colorspace).height[1];
 
-        this->vcaFrame.planes[1] = this->data.data() + planeSizeBytes[0];
-        this->vcaFrame.planes[2] = this->data.data() + planeSizeBytes[0] + planeSizeBytes[1];
-        this->vcaFrame.stride[1] = widthChroma * pixelbytes;
-        this->vcaFrame.stride[2] = widthChroma * pixelbytes;
-        this->vcaFrame.height[1] = heightChroma;
-        this->vcaFrame.height[2] = heightChroma;
+        this->planeOffsetBytes[1] = planeSizeBytes[0];
+        this->planeOffsetBytes[2] = planeSizeBytes[0] + planeSizeBytes[1];
+        this->vcaFrame.stride[1]  = widthChroma * pixelbytes;
+        this->vcaFrame.stride[2]  = widthChroma * pixelbytes;
+        this->vcaFrame.height[1]  = heightChroma;
+        this->vcaFrame.height[2]  = heightChroma;
     }
+
+    if (allocateData)
+        this->allocateData();
+}
+
+void FrameWithData::setPlaneData(uint8_t *frameData)
+{
+    this->vcaFrame.planes[0] = frameData;
+    if (vca_cli_csps.at(this->vcaFrame.info.colorspace).planes > 1)
+    {
+        this->vcaFrame.planes[1] = frameData + this->planeOffsetBytes[1];
+        this->vcaFrame.planes[2] = frameData + this->planeOffsetBytes[2];
+    }
+}
+
+void FrameWithData::allocateData()
+{
+    if (this->data.size() < this->frameSizeBytes)
+        this->data.resize(this->frameSizeBytes);
+
+    this->setPlaneData(this->data.data());
+}
+
+uint8_t *FrameWithData::allocateAlignedData(size_t alignment, size_t sizeBytes)
+{
+    if (this->data.size() < sizeBytes + alignment)
+        this->data.resize(sizeBytes + alignment);
+
+    const auto address = reinterpret_cast<uintptr_t>(this->data.data());
+    return this->data.data() + (alignment - address % alignment) % alignment;
+}
+
+void FrameWithData::swap(FrameWithData &other)
+{
+    // The buffers of the vectors are exchanged, so the planes stay valid
+    std::swap(this->data, other.data);
+    std::swap(this->frameSizeBytes, other.frameSizeBytes);
+    std::swap(this->planeOffsetBytes, other.planeOffsetBytes);
+    std::swap(this->vcaFrame, other.vcaFrame);
 }
 
 void vca_log(LogLevel level, std::string error)
@@ -32,7 +32,8 @@ class FrameWithData
 {
 public:
     FrameWithData() = delete;
-    FrameWithData(const vca_frame_info &frameInfo);
+    // If no data is allocated, the planes must be set using setPlaneData or allocateData.
+    FrameWithData(const vca_frame_info &frameInfo, bool allocateData = true);
     ~FrameWithData() = default;
 
     uint8_t *getData() const
@@ -41,15 +42,29 @@ public:
     }
     size_t getFrameSize() const
     {
-        return this->data.size();
+        return this->frameSizeBytes;
     }
     vca_frame *getFrame()
     {
         return &this->vcaFrame;
     }
 
+    // Point the planes to the samples of a frame in external memory (e.g. a memory mapped file).
+    // The memory must stay valid until the analyzer returned the result of the frame.
+    void setPlaneData(uint8_t *frameData);
+    // Point the planes to the data owned by this frame. It is allocated if needed.
+    void allocateData();
+    // Allocate sizeBytes of owned data starting at an address aligned to alignment (e.g. for
+    // reading with O_DIRECT). Returns the aligned start. The planes are not changed.
+    uint8_t *allocateAlignedData(size_t alignment, size_t sizeBytes);
+
+    // Exchange the data and planes with another frame of the same format
+    void swap(FrameWithData &other);
+
 private:
     std::vector<uint8_t> data;
+    size_t frameSizeBytes{};
+    size_t planeOffsetBytes[3]{};
     vca_frame vcaFrame;
 };
 
@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "AsyncFrameReader.h"
+
+#include <algorithm>
+
+namespace vca {
+
+AsyncFrameReader::AsyncFrameReader(IInputFile &input,
+                                   unsigned skipFrames,
+                                   unsigned nrFrames,
+                                   unsigned prefetchDepth)
+    : input(input)
+    , skipFrames(skipFrames)
+    , nrFrames(nrFrames)
+    , prefetchDepth(std::max(prefetchDepth, 1u))
+{
+    this->thread = std::thread(&AsyncFrameReader::readFrames, this);
+}
+
+AsyncFrameReader::~AsyncFrameReader()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->access);
+        this->aborted = true;
+    }
+    this->frameTaken.notify_all();
+    this->thread.join();
+}
+
+AsyncFrameReader::FramePtr AsyncFrameReader::getNextFrame()
+{
+    std::unique_lock<std::mutex> lock(this->access);
+    this->frameRead.wait(lock, [this]() { return !this->readyFrames.empty() || this->endOfInput; });
+
+    if (this->readyFrames.empty())
+    {
+        if (this->readError)
+            std::rethrow_exception(this->readError);
+        return {};
+    }
+
+    auto frame = std::move(this->readyFrames.front());
+    this->readyFrames.pop();
+    lock.unlock();
+
+    this->frameTaken.notify_one();
+    return frame;
+}
+
+void AsyncFrameReader::recycleFrame(FramePtr frame)
+{
+    std::unique_lock<std::mutex> lock(this->access);
+    this->freeFrames.push(std::move(frame));
+}
+
+AsyncFrameReader::FramePtr AsyncFrameReader::getFreeFrame()
+{
+    std::unique_lock<std::mutex> lock(this->access);
+    this->frameTaken.wait(lock, [this]() {
+        return this->readyFrames.size() < this->prefetchDepth || this->aborted;
+    });
+    if (this->aborted)
+        return {};
+
+    // New buffers are only allocated while the analyzer holds all other ones. So the number of
+    // buffers is bounded by the frames in the analyzer plus the prefetched ones.
+    if (this->freeFrames.empty())
+    {
+        lock.unlock();
+        return this->input.createFrame();
+    }
+
+    auto frame = std::move(this->freeFrames.front());
+    this->freeFrames.pop();
+    return frame;
+}
+
+void AsyncFrameReader::readFrames()
+{
+    unsigned framesRead    = 0;
+    unsigned skippedFrames = 0;
+    try
+    {
+        while (!this->input.isEof() && !this->input.isFail()
+               && (this->nrFrames == 0 || framesRead < this->nrFrames))
+        {
+            auto frame = this->getFreeFrame();
+            if (!frame || !this->input.readFrame(*frame))
+                break;
+
+            if (skippedFrames < this->skipFrames)
+            {
+                this->recycleFrame(std::move(frame));
+                skippedFrames++;
+                vca_log(LogLevel::Debug, "Skipped frame " + std::to_string(skippedFrames));
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(this->access);
+            this->readyFrames.push(std::move(frame));
+            lock.unlock();
+            this->frameRead.notify_one();
+            framesRead++;
+        }
+    }
+    catch (...)
+    {
+        std::unique_lock<std::mutex> lock(this->access);
+        this->readError = std::current_exception();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(this->access);
+        this->endOfInput = true;
+    }
+    this->frameRead.notify_one();
+}
+
+} // namespace vca
@@ -0,0 +1,75 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include "IInputFile.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace vca {
+
+// Reads the frames of an input file in its own thread so that reading the next frames overlaps
+// with the analysis of the current ones. Up to prefetchDepth frames are read ahead. The buffers of
+// analyzed frames are handed back with recycleFrame and are reused for reading.
+class AsyncFrameReader
+{
+public:
+    using FramePtr = std::unique_ptr<FrameWithData>;
+
+    AsyncFrameReader() = delete;
+    // Skips skipFrames frames and then reads up to nrFrames frames (0 for all). The input must not
+    // be used by anyone else until the reader is destroyed.
+    AsyncFrameReader(IInputFile &input,
+                     unsigned skipFrames,
+                     unsigned nrFrames,
+                     unsigned prefetchDepth);
+    ~AsyncFrameReader();
+
+    // Wait for the next frame. Returns nullptr at the end of the input. An error while reading is
+    // rethrown here.
+    FramePtr getNextFrame();
+    void recycleFrame(FramePtr frame);
+
+private:
+    void readFrames();
+    FramePtr getFreeFrame();
+
+    IInputFile &input;
+    unsigned skipFrames{};
+    unsigned nrFrames{};
+    unsigned prefetchDepth{};
+
+    std::mutex access;
+    std::condition_variable frameRead;
+    std::condition_variable frameTaken;
+    std::queue<FramePtr> readyFrames;
+    std::queue<FramePtr> freeFrames;
+    bool endOfInput{};
+    bool aborted{};
+    std::exception_ptr readError;
+
+    std::thread thread;
+};
+
+} // namespace vca
@@ -0,0 +1,294 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "DirectInput.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/aio_abi.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace vca {
+
+#if defined(__linux__)
+
+namespace {
+
+// O_DIRECT needs the buffer, file offset and size aligned to the logical block size of the
+// device. The page size is a multiple of it on all common devices.
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+size_t alignDown(size_t value)
+{
+    return value / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+}
+
+size_t alignUp(size_t value)
+{
+    return alignDown(value + DIRECT_IO_ALIGNMENT - 1);
+}
+
+// glibc has no wrappers for the kernel AIO system calls
+int io_setup(unsigned nrEvents, aio_context_t *context)
+{
+    return int(syscall(__NR_io_setup, nrEvents, context));
+}
+
+int io_destroy(aio_context_t context)
+{
+    return int(syscall(__NR_io_destroy, context));
+}
+
+int io_submit(aio_context_t context, long nr, struct iocb **iocbs)
+{
+    return int(syscall(__NR_io_submit, context, nr, iocbs));
+}
+
+int io_getevents(aio_context_t context, long minNr, long maxNr, struct io_event *events)
+{
+    return int(syscall(__NR_io_getevents, context, minNr, maxNr, events, nullptr));
+}
+
+} // namespace
+
+DirectInput::DirectInput(std::string &fileName,
+                         vca_frame_info &openFrameInfo,
+                         unsigned nrReadsInFlight)
+{
+    if (fileName == "stdin")
+    {
+        vca_log(LogLevel::Warning, "Direct I/O is not possible for stdin");
+        return;
+    }
+
+    this->frameInfo = openFrameInfo;
+    if (this->frameInfo.width == 0 || this->frameInfo.height == 0
+        || this->frameInfo.bitDepth == 0)
+    {
+        vca_log(LogLevel::Error,
+                "yuv: width, height, and bitDepth must be specified to open a raw YUV file");
+        return;
+    }
+
+    vca_log(LogLevel::Info, "Opening input file " + fileName + " for direct I/O");
+    this->fd = open(fileName.c_str(), O_RDONLY | O_DIRECT);
+    if (this->fd < 0)
+    {
+        vca_log(LogLevel::Warning,
+                "Error opening input with O_DIRECT: " + std::string(strerror(errno)));
+        return;
+    }
+
+    struct stat fileStat;
+    if (fstat(this->fd, &fileStat) != 0)
+    {
+        vca_log(LogLevel::Warning, "Error reading size of input " + fileName);
+        return;
+    }
+
+    this->frameSizeBytes = calculateFrameBytesInInput(this->frameInfo);
+    this->frameCount     = unsigned(size_t(fileStat.st_size) / this->frameSizeBytes);
+    vca_log(LogLevel::Info, "Detected " + std::to_string(this->frameCount) + " frames in input");
+
+    nrReadsInFlight = std::max(nrReadsInFlight, 1u);
+    aio_context_t context{};
+    if (io_setup(nrReadsInFlight, &context) != 0)
+    {
+        vca_log(LogLevel::Warning,
+                "Error setting up asynchronous I/O: " + std::string(strerror(errno)));
+        return;
+    }
+    this->ioContext = context;
+
+    for (unsigned i = 0; i < nrReadsInFlight; i++)
+        if (!this->submitRead(this->createFrame()))
+            return;
+
+    // Errors of O_DIRECT (e.g. if the file system does not support it) only show up when a read
+    // completes. Wait for the first one so that another reader can still be used.
+    if (!this->pendingReads.empty() && !this->waitForRead(this->pendingReads.front()))
+        return;
+
+    this->fail = false;
+}
+
+DirectInput::~DirectInput()
+{
+    // Waits for the reads that are still in flight before the buffers are freed
+    if (this->ioContext != 0)
+        io_destroy(this->ioContext);
+    if (this->fd >= 0)
+        close(this->fd);
+}
+
+bool DirectInput::submitRead(std::unique_ptr<FrameWithData> frame)
+{
+    if (this->nextFrameToSubmit >= this->frameCount)
+        return true;
+
+    const auto frameIndex = this->nextFrameToSubmit;
+    const auto offset     = frameIndex * this->frameSizeBytes;
+    const auto readStart  = alignDown(offset);
+    const auto readSize   = alignUp(offset - readStart + this->frameSizeBytes);
+
+    auto buffer = frame->allocateAlignedData(DIRECT_IO_ALIGNMENT, readSize);
+    frame->setPlaneData(buffer + (offset - readStart));
+
+    struct iocb request
+    {};
+    request.aio_data       = frameIndex;
+    request.aio_lio_opcode = IOCB_CMD_PREAD;
+    request.aio_fildes     = uint32_t(this->fd);
+    request.aio_buf        = uint64_t(reinterpret_cast<uintptr_t>(buffer));
+    request.aio_nbytes     = readSize;
+    request.aio_offset     = int64_t(readStart);
+
+    struct iocb *requests[1] = {&request};
+    if (io_submit(this->ioContext, 1, requests) != 1)
+    {
+        vca_log(LogLevel::Warning, "Error submitting read: " + std::string(strerror(errno)));
+        return false;
+    }
+
+    PendingRead read;
+    read.frame      = std::move(frame);
+    read.frameIndex = frameIndex;
+    this->pendingReads.push_back(std::move(read));
+    this->nextFrameToSubmit++;
+    return true;
+}
+
+bool DirectInput::waitForRead(PendingRead &read)
+{
+    // The reads can complete in any order. Results of later reads are kept until they are needed.
+    while (!read.done)
+    {
+        struct io_event events[16];
+        const auto nrEvents = io_getevents(this->ioContext, 1, 16, events);
+        if (nrEvents < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            vca_log(LogLevel::Warning, "Error waiting for read: " + std::string(strerror(errno)));
+            return false;
+        }
+
+        for (int i = 0; i < nrEvents; i++)
+        {
+            auto pending = std::find_if(this->pendingReads.begin(),
+                                        this->pendingReads.end(),
+                                        [&](const PendingRead &r) {
+                                            return r.frameIndex == events[i].data;
+                                        });
+            if (pending != this->pendingReads.end())
+            {
+                pending->done   = true;
+                pending->result = events[i].res;
+            }
+        }
+    }
+
+    const auto offset      = read.frameIndex * this->frameSizeBytes;
+    const auto bytesNeeded = int64_t(offset - alignDown(offset) + this->frameSizeBytes);
+    if (read.result < 0)
+    {
+        vca_log(LogLevel::Warning,
+                "Error reading with O_DIRECT: " + std::string(strerror(int(-read.result))));
+        return false;
+    }
+    if (read.result < bytesNeeded)
+    {
+        vca_log(LogLevel::Warning, "Short read from input with O_DIRECT");
+        return false;
+    }
+    return true;
+}
+
+bool DirectInput::readFrame(FrameWithData &frame)
+{
+    if (this->fail || this->eof)
+        return false;
+
+    if (this->pendingReads.empty())
+    {
+        this->eof = true;
+        return false;
+    }
+
+    auto &read = this->pendingReads.front();
+    if (!this->waitForRead(read))
+        throw std::runtime_error("Error reading from file");
+
+    // Hand out the read buffer and read the next frame into the buffer of the given frame
+    frame.swap(*read.frame);
+    auto freeFrame = std::move(read.frame);
+    this->pendingReads.pop_front();
+
+    if (!this->submitRead(std::move(freeFrame)))
+        throw std::runtime_error("Error reading from file");
+
+    return true;
+}
+
+#else
+
+DirectInput::DirectInput(std::string &, vca_frame_info &, unsigned)
+{
+    vca_log(LogLevel::Warning, "Direct I/O is only supported on Linux");
+}
+
+DirectInput::~DirectInput() {}
+
+bool DirectInput::readFrame(FrameWithData &)
+{
+    return false;
+}
+
+#endif
+
+std::unique_ptr<FrameWithData> DirectInput::createFrame() const
+{
+    // The aligned buffers are allocated when a read is submitted
+    return std::make_unique<FrameWithData>(this->frameInfo, false);
+}
+
+bool DirectInput::isEof() const
+{
+    return this->eof;
+}
+
+bool DirectInput::isFail() const
+{
+    return this->fail;
+}
+
+double DirectInput::getFPS() const
+{
+    return 0.0;
+}
+
+} // namespace vca
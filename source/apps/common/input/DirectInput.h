@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include "IInputFile.h"
+
+#include <deque>
+
+namespace vca {
+
+// Reads a raw YUV file with O_DIRECT, bypassing the page cache. Several frames are read
+// asynchronously (Linux kernel AIO) into aligned frame buffers while the previous frames are
+// analyzed. Only supported on Linux and not for stdin or Y4M files. If the file can not be read
+// this way, the input fails and another reader must be used.
+class DirectInput : public IInputFile
+{
+public:
+    DirectInput() = delete;
+    DirectInput(std::string &fileName, vca_frame_info &openFrameInfo, unsigned nrReadsInFlight);
+    ~DirectInput();
+
+    std::unique_ptr<FrameWithData> createFrame() const override;
+    bool readFrame(FrameWithData &frame) override;
+
+    bool isEof() const override;
+    bool isFail() const override;
+
+    double getFPS() const override;
+
+private:
+    struct PendingRead
+    {
+        std::unique_ptr<FrameWithData> frame;
+        size_t frameIndex{};
+        bool done{};
+        // The number of bytes read or the negative error code
+        int64_t result{};
+    };
+
+    bool submitRead(std::unique_ptr<FrameWithData> frame);
+    bool waitForRead(PendingRead &read);
+
+    int fd{-1};
+    unsigned long ioContext{};
+
+    size_t frameSizeBytes{};
+    size_t nextFrameToSubmit{};
+    std::deque<PendingRead> pendingReads;
+
+    bool eof{};
+    bool fail{true};
+};
+
+} // namespace vca
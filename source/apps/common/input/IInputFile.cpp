@@ -33,6 +33,11 @@
 
 namespace vca {
 
+std::unique_ptr<FrameWithData> IInputFile::createFrame() const
+{
+    return std::make_unique<FrameWithData>(this->frameInfo);
+}
+
 bool IInputFile::isEof() const
 {
     return !this->input || this->input->eof();
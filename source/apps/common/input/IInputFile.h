@@ -29,6 +29,7 @@
 #define MAX_FRAME_HEIGHT 8640
 
 #include <fstream>
+#include <memory>
 
 namespace vca {
 
@@ -44,10 +45,12 @@ protected:
 public:
     virtual ~IInputFile() {}
 
+    // Create a frame that readFrame can read into
+    virtual std::unique_ptr<FrameWithData> createFrame() const;
     virtual bool readFrame(FrameWithData &frame) = 0;
 
-    bool isEof() const;
-    bool isFail() const;
+    virtual bool isEof() const;
+    virtual bool isFail() const;
 
     vca_frame_info getFrameInfo() const;
     virtual double getFPS() const = 0;
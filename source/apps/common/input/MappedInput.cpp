@@ -0,0 +1,240 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "MappedInput.h"
+
+#include "Y4MInput.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vca {
+
+MappedInput::MappedInput(std::string &fileName, vca_frame_info &openFrameInfo, bool isY4m)
+    : isY4m(isY4m)
+{
+    if (fileName == "stdin")
+    {
+        vca_log(LogLevel::Error, "Memory mapping is not possible for stdin");
+        return;
+    }
+
+    if (isY4m)
+    {
+        if (!this->openInput(fileName))
+        {
+            vca_log(LogLevel::Error, "Error opening input " + fileName);
+            return;
+        }
+        if (!parseY4MHeader(*this->input, this->frameInfo, this->fps))
+        {
+            vca_log(LogLevel::Error, "Error parsing Y4M header");
+            return;
+        }
+        // The frames are read from the mapping after the header
+        this->readPosition = size_t(this->input->tellg());
+        this->inputFile.close();
+        this->input = nullptr;
+    }
+    else
+    {
+        this->frameInfo = openFrameInfo;
+        if (this->frameInfo.width == 0 || this->frameInfo.height == 0
+            || this->frameInfo.bitDepth == 0)
+        {
+            vca_log(LogLevel::Error,
+                    "yuv: width, height, and bitDepth must be specified to open a raw YUV file");
+            return;
+        }
+    }
+
+    if (!this->mapFile(fileName))
+        return;
+
+    this->frameSizeBytes = calculateFrameBytesInInput(this->frameInfo);
+
+    const auto frameHeaderSize = isY4m ? 6u : 0u;
+    this->frameCount = unsigned(this->mappingSize / (this->frameSizeBytes + frameHeaderSize));
+    vca_log(LogLevel::Info, "Detected " + std::to_string(this->frameCount) + " frames in input");
+
+    this->fail = false;
+}
+
+MappedInput::~MappedInput()
+{
+#ifndef _WIN32
+    if (this->mapping != nullptr)
+        munmap(this->mapping, this->mappingSize);
+#endif
+}
+
+#ifndef _WIN32
+bool MappedInput::mapFile(std::string &fileName)
+{
+    vca_log(LogLevel::Info, "Memory mapping input file " + fileName);
+
+    const auto fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        vca_log(LogLevel::Error, "Error opening input " + fileName + ": " + strerror(errno));
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+        vca_log(LogLevel::Error, "Error reading size of input " + fileName);
+        close(fd);
+        return false;
+    }
+
+    this->mappingSize = size_t(fileStat.st_size);
+    if (this->mappingSize == 0)
+    {
+        // An empty mapping is not possible. There is just nothing to read.
+        this->eof = true;
+        close(fd);
+        return true;
+    }
+
+    // The analyzer only reads the planes so the mapping is read only
+    auto mapping = mmap(nullptr, this->mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        vca_log(LogLevel::Error, "Error memory mapping input " + fileName + ": " + strerror(errno));
+        this->mappingSize = 0;
+        return false;
+    }
+    this->mapping = static_cast<uint8_t *>(mapping);
+
+    // Let the kernel read ahead aggressively and drop pages that were already read
+    if (madvise(this->mapping, this->mappingSize, MADV_SEQUENTIAL) != 0)
+        vca_log(LogLevel::Warning,
+                "madvise(MADV_SEQUENTIAL) failed: " + std::string(strerror(errno)));
+
+    return true;
+}
+#else
+bool MappedInput::mapFile(std::string &)
+{
+    vca_log(LogLevel::Error, "Memory mapping of the input is not supported on this platform");
+    return false;
+}
+#endif
+
+std::unique_ptr<FrameWithData> MappedInput::createFrame() const
+{
+    // The planes are pointed into the mapping for each frame
+    return std::make_unique<FrameWithData>(this->frameInfo, false);
+}
+
+bool MappedInput::skipY4MFrameHeader()
+{
+    auto data = this->mapping;
+    auto end  = this->mappingSize;
+    auto &pos = this->readPosition;
+
+    while (pos < end && data[pos] != 'F')
+        pos++;
+    if (pos == end)
+        return false;
+
+    if (end - pos < 5 || std::memcmp(data + pos, "FRAME", 5) != 0)
+        throw std::runtime_error("Error reading FRAME tag");
+
+    while (pos < end && data[pos] != '\n')
+        pos++;
+    if (pos == end)
+        return false;
+
+    pos++;
+    return true;
+}
+
+bool MappedInput::readFrame(FrameWithData &frame)
+{
+    if (this->fail || this->eof)
+        return false;
+
+    if (this->isY4m && !this->skipY4MFrameHeader())
+    {
+        this->eof = true;
+        return false;
+    }
+
+    if (this->mappingSize - this->readPosition < this->frameSizeBytes)
+    {
+        this->eof = true;
+        return false;
+    }
+
+    auto frameData = this->mapping + this->readPosition;
+
+    // 16 bit samples must be aligned. In a Y4M file a frame can start at an odd offset. Only then
+    // the frame is copied.
+    const auto isHighBitDepth = this->frameInfo.bitDepth > 8;
+    if (isHighBitDepth && this->readPosition % 2 != 0)
+    {
+        frame.allocateData();
+        std::memcpy(frame.getData(), frameData, this->frameSizeBytes);
+    }
+    else
+        frame.setPlaneData(frameData);
+
+    this->readPosition += this->frameSizeBytes;
+
+#ifndef _WIN32
+    // Request the next frame now so that it is in memory when it is analyzed
+    const auto pageSize  = size_t(sysconf(_SC_PAGESIZE));
+    const auto nextStart = this->readPosition / pageSize * pageSize;
+    if (nextStart < this->mappingSize)
+        madvise(this->mapping + nextStart,
+                std::min(this->frameSizeBytes + pageSize, this->mappingSize - nextStart),
+                MADV_WILLNEED);
+#endif
+
+    return true;
+}
+
+bool MappedInput::isEof() const
+{
+    return this->eof;
+}
+
+bool MappedInput::isFail() const
+{
+    return this->fail;
+}
+
+double MappedInput::getFPS() const
+{
+    return this->fps;
+}
+
+} // namespace vca
@@ -0,0 +1,58 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include "IInputFile.h"
+
+namespace vca {
+
+// Reads a raw YUV or Y4M file by mapping it into memory. The planes of the frames point directly
+// into the mapping so the samples are not copied. Reading from stdin is not supported.
+class MappedInput : public IInputFile
+{
+public:
+    MappedInput() = delete;
+    MappedInput(std::string &fileName, vca_frame_info &openFrameInfo, bool isY4m);
+    ~MappedInput();
+
+    std::unique_ptr<FrameWithData> createFrame() const override;
+    bool readFrame(FrameWithData &frame) override;
+
+    bool isEof() const override;
+    bool isFail() const override;
+
+    double getFPS() const override;
+
+private:
+    bool mapFile(std::string &fileName);
+    bool skipY4MFrameHeader();
+
+    uint8_t *mapping{};
+    size_t mappingSize{};
+    size_t readPosition{};
+    size_t frameSizeBytes{};
+
+    bool isY4m{};
+    bool eof{};
+    bool fail{true};
+    double fps{};
+};
+
+} // namespace vca
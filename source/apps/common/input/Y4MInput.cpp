@@ -39,7 +39,7 @@ Y4MInput::Y4MInput(std::string &fileName)
         return;
     }
 
-    if (!this->parseHeader())
+    if (!parseY4MHeader(*this->input, this->frameInfo, this->fps))
     {
         vca_log(LogLevel::Error, "Error parsing Y4M header");
         return;
@@ -55,9 +55,9 @@ Y4MInput::Y4MInput(std::string &fileName)
     }
 }
 
-bool Y4MInput::parseHeader()
+bool parseY4MHeader(std::istream &input, vca_frame_info &frameInfo, double &fps)
 {
-    auto it = std::istreambuf_iterator<char>(*this->input);
+    auto it = std::istreambuf_iterator<char>(input);
 
     auto getNextHeaderField = [&it]() {
         if (*it == '\n')
@@ -91,7 +91,7 @@ bool Y4MInput::parseHeader()
                 vca_log(LogLevel::Error, "Invalid width value: " + field);
                 return false;
             }
-            this->frameInfo.width = val;
+            frameInfo.width = val;
             vca_log(LogLevel::Info, "Y4M read hidth " + std::to_string(val));
         }
         else if (parameterIndicator == 'H')
@@ -102,50 +102,50 @@ bool Y4MInput::parseHeader()
                 vca_log(LogLevel::Error, "Invalid height value: " + field);
                 return false;
             }
-            this->frameInfo.height = val;
+            frameInfo.height = val;
             vca_log(LogLevel::Info, "Y4M read height " + std::to_string(val));
         }
         else if (parameterIndicator == 'C')
         {
             auto subsamplingIndicator = field.substr(1, 3);
             if (subsamplingIndicator == "420")
-                this->frameInfo.colorspace = vca_colorSpace::YUV420;
+                frameInfo.colorspace = vca_colorSpace::YUV420;
             else if (subsamplingIndicator == "422")
-                this->frameInfo.colorspace = vca_colorSpace::YUV422;
+                frameInfo.colorspace = vca_colorSpace::YUV422;
             else if (subsamplingIndicator == "444")
-                this->frameInfo.colorspace = vca_colorSpace::YUV444;
+                frameInfo.colorspace = vca_colorSpace::YUV444;
             else
             {
                 vca_log(LogLevel::Info,
                         "Y4M invalid colorspace indicator (" + subsamplingIndicator
                             + "). Assuming 4:2:0.");
-                this->frameInfo.colorspace = vca_colorSpace::YUV420;
+                frameInfo.colorspace = vca_colorSpace::YUV420;
             }
 
             if (field.size() > 3)
             {
                 auto additionalPart = field.substr(4);
                 if (additionalPart == "p10")
-                    this->frameInfo.bitDepth = 10;
+                    frameInfo.bitDepth = 10;
                 else if (additionalPart == "p12")
-                    this->frameInfo.bitDepth = 12;
+                    frameInfo.bitDepth = 12;
                 else if (additionalPart == "p14")
-                    this->frameInfo.bitDepth = 14;
+                    frameInfo.bitDepth = 14;
                 else if (additionalPart == "p16")
-                    this->frameInfo.bitDepth = 16;
+                    frameInfo.bitDepth = 16;
                 else
                 {
                     vca_log(LogLevel::Info,
                             "Y4M invalid additional part in colorspace indicator (" + additionalPart
                                 + "). Assuming 8 bit.");
-                    this->frameInfo.bitDepth = 8;
+                    frameInfo.bitDepth = 8;
                 }
             }
 
             vca_log(LogLevel::Info,
                     "Y4M Detected colorspace "
-                        + vca_colorSpaceMapper.getName(this->frameInfo.colorspace)
-                        + " with bit depth " + std::to_string(this->frameInfo.bitDepth));
+                        + vca_colorSpaceMapper.getName(frameInfo.colorspace)
+                        + " with bit depth " + std::to_string(frameInfo.bitDepth));
         }
         else if (parameterIndicator == 'F')
         {
@@ -158,9 +158,9 @@ bool Y4MInput::parseHeader()
 
             try
             {
-                auto num  = std::stoi(field.substr(1, colonPos - 1));
-                auto den  = std::stoi(field.substr(colonPos + 1));
-                this->fps = double(num) / double(den);
+                auto num = std::stoi(field.substr(1, colonPos - 1));
+                auto den = std::stoi(field.substr(colonPos + 1));
+                fps      = double(num) / double(den);
                 vca_log(LogLevel::Info,
                         "Y4M Detected fps " + std::to_string(num) + "/" + std::to_string(den));
             }
@@ -23,11 +23,12 @@
 
 namespace vca {
 
+// Parse the stream header up to the end of the header line. The first frame follows.
+bool parseY4MHeader(std::istream &input, vca_frame_info &frameInfo, double &fps);
+
 class Y4MInput : public IInputFile
 {
 protected:
-    bool parseHeader();
-
     double fps{};
 
 public:
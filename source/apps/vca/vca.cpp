@@ -20,20 +20,34 @@
 
 #include "vcacli.h"
 
+#include <common/input/AsyncFrameReader.h>
+#include <common/input/DirectInput.h>
+#include <common/input/MappedInput.h>
 #include <common/input/Y4MInput.h>
 #include <common/input/YUVInput.h>
 #include <common/stats/YUViewStatsFile.h>
 #include <lib/vcaLib.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <optional>
 #include <signal.h>
 #include <queue>
+#include <thread>
 #include <cmath>
 
+#ifdef FILESYSTEM_EXPERIMENTAL
+#include <experimental/filesystem>
+namespace filesystem = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace filesystem = std::filesystem;
+#endif
+
 #ifdef _WIN32
 #include <windows.h>
 #pragma warning(disable : 4996)
@@ -42,6 +56,11 @@
 using namespace vca;
 using namespace std::string_literals;
 
+// The number of frames that the reader thread reads ahead of the analysis
+constexpr unsigned PREFETCH_FRAMES = 8;
+// The number of frames read at the same time with --direct-io
+constexpr unsigned DIRECT_IO_READS_IN_FLIGHT = 4;
+
 /* Ctrl-C handler */
 static volatile sig_atomic_t b_ctrl_c /* = 0 */;
 static void sigint_handler(int)
@@ -109,6 +128,11 @@ struct CLIOptions
 {
     std::string inputFilename;
     bool openAsY4m{};
+    bool mapInput{};
+    bool directIO{};
+    std::string batchListFilename;
+    unsigned batchParallel{4};
+    std::string batchOutputDir{"."};
     unsigned skipFrames{};
     unsigned framesToBeAnalyzed{};
     unsigned segmentSize{};
@@ -142,6 +166,11 @@ struct Result
     vca_frame_results result;
 };
 
+bool hasY4mExtension(const std::string &filename)
+{
+    return filename.size() >= 4 && filename.substr(filename.size() - 4) == ".y4m";
+}
+
 std::optional<CLIOptions> parseCLIOptions(int argc, char **argv)
 {
     bool bError = false;
@@ -214,6 +243,10 @@ std::optional<CLIOptions> parseCLIOptions(int argc, char **argv)
             options.vcaParam.enableEdgeDensity = false;
         else if (name == "y4m")
             options.openAsY4m = true;
+        else if (name == "mmap")
+            options.mapInput = true;
+        else if (name == "direct-io")
+            options.directIO = true;
         else
         {
             auto arg = std::string(optarg);
@@ -267,13 +300,20 @@ std::optional<CLIOptions> parseCLIOptions(int argc, char **argv)
                 options.shotDetectParam.maxSadThresh = std::stod(optarg);
             else if (name == "block-size")
                 options.vcaParam.blockSize = std::stoi(optarg);
+            else if (name == "batch")
+                options.batchListFilename = optarg;
+            else if (name == "batch-parallel")
+                options.batchParallel = std::stoul(optarg);
+            else if (name == "batch-output-dir")
+                options.batchOutputDir = optarg;
             else if (name == "threads")
                 options.vcaParam.nrFrameThreads = std::stoi(optarg);
+            else if (name == "slice-threads")
+                options.vcaParam.nrSliceThreads = std::stoi(optarg);
         }
     }
 
-    if (options.inputFilename.size() >= 4
-        && options.inputFilename.substr(options.inputFilename.size() - 4) == ".y4m")
+    if (hasY4mExtension(options.inputFilename))
         options.openAsY4m = true;
 
     return options;
@@ -281,12 +321,36 @@ std::optional<CLIOptions> parseCLIOptions(int argc, char **argv)
 
 bool checkOptions(CLIOptions options)
 {
-    if (options.inputFilename.empty())
+    const auto batchMode = !options.batchListFilename.empty();
+    if (options.inputFilename.empty() && !batchMode)
     {
         vca_log(LogLevel::Error, "No input filename specified");
         return false;
     }
 
+    if (batchMode
+        && (!options.inputFilename.empty() || !options.complexityCSVFilename.empty()
+            || !options.shotCSVFilename.empty() || !options.segmentFeatureCSVFilename.empty()
+            || !options.yuviewStatsFilename.empty()))
+    {
+        vca_log(LogLevel::Error,
+                "In batch mode the inputs are read from the list and the output files are named "
+                "after the inputs. --input and the output file options can not be used.");
+        return false;
+    }
+
+    if (options.mapInput && options.inputFilename == "stdin")
+    {
+        vca_log(LogLevel::Error, "The input can not be memory mapped when reading from stdin.");
+        return false;
+    }
+
+    if (options.mapInput && options.directIO)
+    {
+        vca_log(LogLevel::Error, "Memory mapping and direct I/O can not be combined.");
+        return false;
+    }
+
     const auto bitDepth = options.vcaParam.frameInfo.bitDepth;
     if (bitDepth != 8 && bitDepth != 10 && bitDepth != 12)
     {
@@ -294,7 +358,8 @@ bool checkOptions(CLIOptions options)
         return false;
     }
 
-    if (!options.openAsY4m
+    // In batch mode the frame size is only needed if the list contains raw YUV files
+    if (!options.openAsY4m && !batchMode
         && (options.vcaParam.frameInfo.width == 0 || options.vcaParam.frameInfo.height == 0))
     {
         vca_log(LogLevel::Error, "No frame size provided.");
@@ -322,7 +387,15 @@ void logOptions(const CLIOptions &options)
 {
     vca_log(LogLevel::Info, "Options:   "s);
     vca_log(LogLevel::Info, "  Input file name:   "s + options.inputFilename);
+    if (!options.batchListFilename.empty())
+    {
+        vca_log(LogLevel::Info, "  Batch list:        "s + options.batchListFilename);
+        vca_log(LogLevel::Info, "  Batch parallel:    "s + std::to_string(options.batchParallel));
+        vca_log(LogLevel::Info, "  Batch output dir:  "s + options.batchOutputDir);
+    }
     vca_log(LogLevel::Info, "  Open as Y4m:       "s + (options.openAsY4m ? "True"s : "False"s));
+    vca_log(LogLevel::Info, "  Memory map input:  "s + (options.mapInput ? "True"s : "False"s));
+    vca_log(LogLevel::Info, "  Direct I/O input:  "s + (options.directIO ? "True"s : "False"s));
     vca_log(LogLevel::Info,
             "  Enable SIMD:       "s + (options.vcaParam.enableSIMD ? "True"s : "False"s));
     vca_log(LogLevel::Info,
@@ -346,6 +419,30 @@ void logOptions(const CLIOptions &options)
     vca_log(LogLevel::Info, "  YUView stats file: "s + options.yuviewStatsFilename);
 }
 
+std::unique_ptr<IInputFile> openInputFile(CLIOptions &options)
+{
+    if (options.directIO)
+    {
+        if (!options.openAsY4m)
+        {
+            auto directInput = std::make_unique<DirectInput>(options.inputFilename,
+                                                             options.vcaParam.frameInfo,
+                                                             DIRECT_IO_READS_IN_FLIGHT);
+            if (!directInput->isFail())
+                return directInput;
+        }
+        vca_log(LogLevel::Warning, "Direct I/O is not possible for this input. Reading normally.");
+    }
+
+    if (options.mapInput)
+        return std::make_unique<MappedInput>(options.inputFilename,
+                                             options.vcaParam.frameInfo,
+                                             options.openAsY4m);
+    if (options.openAsY4m)
+        return std::make_unique<Y4MInput>(options.inputFilename);
+    return std::make_unique<YUVInput>(options.inputFilename, options.vcaParam.frameInfo);
+}
+
 void logResult(const Result &result, const vca_frame *frame, const unsigned resultsCounter)
 {
     if (result.result.poc != frame->stats.poc)
@@ -552,40 +649,10 @@ static int get_argv_utf8(int *argc_ptr, char ***argv_ptr)
 }
 #endif
 
-int main(int argc, char **argv)
+// Analyze one input and write the requested output files. Returns the exit code.
+int analyzeInput(CLIOptions options, bool showStatus)
 {
-#if _WIN32
-    char **orgArgv = argv;
-    get_argv_utf8(&argc, &argv);
-#endif
-
-    // This first logging command will set the global log level. So if you want to increase it,
-    // you can do so here.
-    vca_log(LogLevel::Info, "VCA - Video Complexity Analyzer " + std::string(vca_version_str));
-
-    CLIOptions options;
-    if (auto cliOptions = parseCLIOptions(argc, argv))
-        options = *cliOptions;
-    else
-    {
-        vca_log(LogLevel::Error, "Error parsing parameters");
-        return 1;
-    }
-
-    if (!checkOptions(options))
-    {
-        vca_log(LogLevel::Error, "Error checking parameters");
-        return 1;
-    }
-
-    logOptions(options);
-
-    std::unique_ptr<IInputFile> inputFile;
-    if (options.openAsY4m)
-        inputFile = std::make_unique<Y4MInput>(options.inputFilename);
-    else
-        inputFile = std::make_unique<YUVInput>(options.inputFilename, options.vcaParam.frameInfo);
-
+    auto inputFile = openInputFile(options);
     if (inputFile->isFail())
     {
         vca_log(LogLevel::Error, "Error opening input file");
@@ -653,23 +720,16 @@ int main(int argc, char **argv)
         return 2;
     }
 
-    /* Control-C handler */
-    if (signal(SIGINT, sigint_handler) == SIG_ERR)
-        vca_log(LogLevel::Error,
-                "Unable to register CTRL+C handler: " + std::string(strerror(errno)));
-
     auto frameInfo = inputFile->getFrameInfo();
 
     vca_log(LogLevel::Debug, "Start main analysis loop");
 
     using framePtr = std::unique_ptr<FrameWithData>;
-    std::queue<framePtr> frameRecycling;
     std::queue<framePtr> activeFrames;
     std::unique_ptr<YUViewStatsFile> yuviewStatsFile;
     std::vector<vca_frame_results> shotDetectFrames;
     unsigned pushedFrames   = 0;
     unsigned resultsCounter = 0;
-    unsigned skippedFrames  = 0;
 
     int Segment_size = 0;
     int T_fps       = 0;
@@ -689,38 +749,32 @@ int main(int argc, char **argv)
     Result segment_result(frameInfo, options.vcaParam.blockSize);
     segment_result_init(&segment_result);
 
-    while (!inputFile->isEof() && !inputFile->isFail()
-           && (options.framesToBeAnalyzed == 0 || pushedFrames < options.framesToBeAnalyzed))
+    // The frames are read in a separate thread while the analyzer works on the previous ones
+    AsyncFrameReader reader(*inputFile,
+                            options.skipFrames,
+                            options.framesToBeAnalyzed,
+                            PREFETCH_FRAMES);
+
+    // The analyzer must be closed before the frames are freed, also if the analysis stops early.
+    // Otherwise the threads could still work on them.
+    std::unique_ptr<vca_analyzer, decltype(&vca_analyzer_close)> analyzerCloser(
+        analyzer, &vca_analyzer_close);
+
+    while (true)
     {
         {
             framePtr frame;
-            if (frameRecycling.empty())
-                frame = std::make_unique<FrameWithData>(inputFile->getFrameInfo());
-            else
-            {
-                frame = std::move(frameRecycling.front());
-                frameRecycling.pop();
-            }
-
             try
             {
-                if (!inputFile->readFrame(*frame))
-                    break;
+                frame = reader.getNextFrame();
             }
             catch (const std::exception &e)
             {
                 vca_log(LogLevel::Error, "Error reading frame from input: " + std::string(e.what()));
                 return 3;
             }
-
-            if (options.skipFrames > 0)
-            {
-                frameRecycling.push(std::move(frame));
-                options.skipFrames--;
-                skippedFrames++;
-                vca_log(LogLevel::Debug, "Skipped frame " + std::to_string(skippedFrames));
-                continue;
-            }
+            if (!frame)
+                break;
 
             frame->getFrame()->stats.poc = pushedFrames;
             vca_log(LogLevel::Debug, "Read frame " + std::to_string(pushedFrames) + " from input");
@@ -796,11 +850,12 @@ int main(int argc, char **argv)
 
             logResult(result, processedFrame->getFrame(), resultsCounter);
 
-            frameRecycling.push(std::move(processedFrame));
+            reader.recycleFrame(std::move(processedFrame));
             resultsCounter++;
         }
 
-        printStatus(resultsCounter, options.framesToBeAnalyzed);
+        if (showStatus)
+            printStatus(resultsCounter, options.framesToBeAnalyzed);
     }
 
     while (resultsCounter < pushedFrames)
@@ -857,8 +912,9 @@ int main(int argc, char **argv)
         resultsCounter++;
     }
 
-    vca_analyzer_close(analyzer);
-    printStatus(resultsCounter, pushedFrames, true);
+    analyzerCloser.reset();
+    if (showStatus)
+        printStatus(resultsCounter, pushedFrames, true);
 
     if (!options.shotCSVFilename.empty())
     {
@@ -890,3 +946,155 @@ int main(int argc, char **argv)
 
     return 0;
 }
+
+std::vector<std::string> readBatchList(const std::string &listFilename)
+{
+    std::vector<std::string> inputs;
+    std::ifstream listFile(listFilename);
+    std::string line;
+    while (std::getline(listFile, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!line.empty())
+            inputs.push_back(line);
+    }
+    return inputs;
+}
+
+// The name of the input file without the directory and extension
+std::string getFileStem(const std::string &filename)
+{
+    const auto separator = filename.find_last_of("/\\");
+    auto stem = (separator == std::string::npos) ? filename : filename.substr(separator + 1);
+    const auto extension = stem.find_last_of('.');
+    if (extension != std::string::npos && extension > 0)
+        stem = stem.substr(0, extension);
+    return stem;
+}
+
+// Analyze all inputs of the batch list. Several inputs are analyzed at the same time, each with
+// its own analyzer on a shared pool of threads. Every input gets a complexity and a shot CSV file
+// named after it.
+int runBatch(const CLIOptions &options)
+{
+    const auto inputs = readBatchList(options.batchListFilename);
+    if (inputs.empty())
+    {
+        vca_log(LogLevel::Error, "No inputs in batch list " + options.batchListFilename);
+        return 1;
+    }
+
+    // The outputs are named after the inputs. Inputs with the same name in different directories
+    // would write the same files.
+    std::map<std::string, std::string> inputByOutputName;
+    for (const auto &input : inputs)
+    {
+        const auto [existing, inserted] = inputByOutputName.emplace(getFileStem(input), input);
+        if (!inserted)
+        {
+            vca_log(LogLevel::Error,
+                    "The inputs " + existing->second + " and " + input
+                        + " would write the same output files. Rename one of them.");
+            return 1;
+        }
+    }
+
+    std::error_code error;
+    filesystem::create_directories(options.batchOutputDir, error);
+    if (error)
+    {
+        vca_log(LogLevel::Error,
+                "Error creating output directory " + options.batchOutputDir + ": "
+                    + error.message());
+        return 1;
+    }
+
+    const auto nrParallel = std::clamp(options.batchParallel, 1u, unsigned(inputs.size()));
+
+    // All analyzers share one pool of worker threads so that the number of threads is bounded no
+    // matter how many inputs are analyzed at the same time
+    auto executor = vca_executor_create(options.vcaParam.nrFrameThreads);
+    if (executor == nullptr)
+    {
+        vca_log(LogLevel::Error, "Error creating the worker threads");
+        return 1;
+    }
+
+    vca_log(LogLevel::Info,
+            "Batch analysis of " + std::to_string(inputs.size()) + " inputs. "
+                + std::to_string(nrParallel) + " in parallel.");
+
+    std::atomic<size_t> nextInput{0};
+    std::atomic<unsigned> nrFailed{0};
+    auto analyzeInputs = [&]() {
+        for (auto i = nextInput++; i < inputs.size(); i = nextInput++)
+        {
+            auto inputOptions          = options;
+            const auto outputPrefix    = options.batchOutputDir + "/" + getFileStem(inputs[i]);
+            inputOptions.inputFilename = inputs[i];
+            inputOptions.openAsY4m     = options.openAsY4m || hasY4mExtension(inputs[i]);
+            inputOptions.complexityCSVFilename   = outputPrefix + ".csv";
+            inputOptions.shotCSVFilename         = outputPrefix + "_shots.csv";
+            inputOptions.vcaParam.executor       = executor;
+
+            vca_log(LogLevel::Info, "Analyzing " + inputs[i]);
+            if (analyzeInput(inputOptions, false) != 0)
+            {
+                vca_log(LogLevel::Error, "Analysis of " + inputs[i] + " failed");
+                nrFailed++;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < nrParallel; i++)
+        workers.emplace_back(analyzeInputs);
+    for (auto &worker : workers)
+        worker.join();
+    vca_executor_destroy(executor);
+
+    vca_log(LogLevel::Info,
+            "Batch analysis done. " + std::to_string(inputs.size() - nrFailed) + " of "
+                + std::to_string(inputs.size()) + " inputs analyzed successfully.");
+    return nrFailed > 0 ? 3 : 0;
+}
+
+int main(int argc, char **argv)
+{
+#if _WIN32
+    char **orgArgv = argv;
+    get_argv_utf8(&argc, &argv);
+#endif
+
+    // This first logging command will set the global log level. So if you want to increase it,
+    // you can do so here.
+    vca_log(LogLevel::Info, "VCA - Video Complexity Analyzer " + std::string(vca_version_str));
+
+    CLIOptions options;
+    if (auto cliOptions = parseCLIOptions(argc, argv))
+        options = *cliOptions;
+    else
+    {
+        vca_log(LogLevel::Error, "Error parsing parameters");
+        return 1;
+    }
+
+    if (!checkOptions(options))
+    {
+        vca_log(LogLevel::Error, "Error checking parameters");
+        return 1;
+    }
+
+    logOptions(options);
+
+    /* Control-C handler */
+    if (signal(SIGINT, sigint_handler) == SIG_ERR)
+        vca_log(LogLevel::Error,
+                "Unable to register CTRL+C handler: " + std::string(strerror(errno)));
+
+    if (!options.batchListFilename.empty())
+        return runBatch(options);
+
+    return analyzeInput(options, true);
+}
@@ -32,6 +32,8 @@ static const struct option long_options[] = {{"help", no_argument, NULL, 'h'},
                                              {"no-lowpass", no_argument, NULL, 0},
                                              {"input", required_argument, NULL, 0},
                                              {"y4m", no_argument, NULL, 0},
+                                             {"mmap", no_argument, NULL, 0},
+                                             {"direct-io", no_argument, NULL, 0},
                                              {"input-depth", required_argument, NULL, 0},
                                              {"input-res", required_argument, NULL, 0},
                                              {"input-csp", required_argument, NULL, 0},
@@ -48,6 +50,10 @@ static const struct option long_options[] = {{"help", no_argument, NULL, 'h'},
                                              {"max-sadthresh", required_argument, NULL, 0},
                                              {"block-size", required_argument, NULL, 0},
                                              {"threads", required_argument, NULL, 0},
+                                             {"slice-threads", required_argument, NULL, 0},
+                                             {"batch", required_argument, NULL, 0},
+                                             {"batch-parallel", required_argument, NULL, 0},
+                                             {"batch-output-dir", required_argument, NULL, 0},
                                              {"no-dctenergy", no_argument, 0},
                                              {"no-entropy", no_argument, 0},
                                              {"no-edgedensity", no_argument, 0},
@@ -67,6 +73,10 @@ static void showHelp()
     printf("   --input <filename>            Raw YUV or Y4M input file name. `stdin` for stdin.");
     printf("   --y4m                         Force parsing of input stream as YUV4MPEG2 regardless "
            "of file extension\n");
+    printf("   --mmap                        Memory map the input file instead of reading it. "
+           "Not for stdin\n");
+    printf("   --direct-io                   Read a raw YUV file with O_DIRECT and several reads "
+           "in flight (Linux)\n");
     printf("   --input-res WxH               Source picture size [w x h], auto-detected if Y4M\n");
     printf("   --input-depth <integer>       Bit-depth of input file. Default 8\n");
     printf("   --input-csp <string>          Chroma subsampling, auto-detected if Y4M\n");
@@ -90,6 +100,12 @@ static void showHelp()
     printf("   --yuview-stats <filename>     Write the per block results (energy, sad) to a stats "
            "file\n");
     printf("                                 that can be visualized using YUView.\n");
+    printf("\nBatch Options:\n");
+    printf("   --batch <filename>            Analyze all inputs listed in the file (one per "
+           "line)\n");
+    printf("   --batch-parallel <integer>    Nr of inputs analyzed at the same time. Default 4\n");
+    printf("   --batch-output-dir <dir>      Directory for the <input>.csv and <input>_shots.csv "
+           "files of the inputs. Default: .\n");
     printf("\nOperation Options:\n");
     printf("   --no-simd                     Disable SIMD. Default: Enabled\n");
     printf("   --no-dctenergy-chroma         Disable chroma for DCT energy. Default: Enabled\n");
@@ -101,6 +117,8 @@ static void showHelp()
     printf("   --block-size <integer>        Block size for DCT transform. Must be 8, 16 or 32 "
            "(Default).\n");
     printf("   --threads <integer>           Nr of threads to use. (Default: 0 (autodetect))\n");
+    printf("   --slice-threads <integer>     Nr of slices each frame is split into for parallel "
+           "analysis. (Default: 0 (one per thread))\n");
     printf("   --no-dctenergy                Disable DCT energy features. Default: Enabled\n");
     printf("   --no-entropy                  Disable entropy features. Default: Enabled\n");
     printf("   -no-edgedensity               Disable edge density calculation. Default: Enabled\n");
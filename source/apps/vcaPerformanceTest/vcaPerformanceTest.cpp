@@ -415,7 +415,9 @@ int main(int argc, char **argv)
                                                          {CpuSimd::SSE2, "SSE2"},
                                                          {CpuSimd::SSSE3, "SSSE3"},
                                                          {CpuSimd::SSE4, "SSE4"},
-                                                         {CpuSimd::AVX2, "AVX2"}};
+                                                         {CpuSimd::AVX2, "AVX2"},
+                                                         {CpuSimd::AVX512, "AVX512"},
+                                                         {CpuSimd::NEON, "NEON"}};
 
     for (auto &simd : cpuSimdNames)
     {
@@ -21,16 +21,81 @@
 #include <analyzer/EntropyCalculation.h>
 #include <analyzer/simd/cpu.h>
 
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <string>
 
 namespace vca {
 
+namespace {
+
+constexpr unsigned MIN_JOB_QUEUE_SIZE = 5;
+// Slots of the ring buffer of an unbounded result queue. More results go to the overflow list.
+constexpr unsigned UNBOUNDED_RESULT_RING_SIZE = 64;
+
+template<typename T>
+T *dataOrNullptr(std::vector<T> &values)
+{
+    return values.empty() ? nullptr : values.data();
+}
+
+// Point the view to the values in the result. The per block values of disabled features are
+// nullptr.
+void fillResultView(vca_frame_results &view, Result &result, const vca_param &cfg)
+{
+    view       = {};
+    view.poc   = result.poc;
+    view.jobID = result.jobID;
+
+    if (cfg.enableDCTenergy)
+    {
+        view.averageBrightness  = result.averageBrightness;
+        view.averageEnergy      = result.averageEnergy;
+        view.energyDiff         = result.energyDiff;
+        view.energyEpsilon      = result.energyEpsilon;
+        view.brightnessPerBlock = dataOrNullptr(result.brightnessPerBlock);
+        view.energyPerBlock     = dataOrNullptr(result.energyPerBlock);
+        view.energyDiffPerBlock = dataOrNullptr(result.energyDiffPerBlock);
+        if (cfg.enableEnergyChroma)
+        {
+            view.averageU         = result.averageU;
+            view.averageV         = result.averageV;
+            view.energyU          = result.energyU;
+            view.energyV          = result.energyV;
+            view.averageUPerBlock = dataOrNullptr(result.averageUPerBlock);
+            view.averageVPerBlock = dataOrNullptr(result.averageVPerBlock);
+            view.energyUPerBlock  = dataOrNullptr(result.energyUPerBlock);
+            view.energyVPerBlock  = dataOrNullptr(result.energyVPerBlock);
+        }
+    }
+    if (cfg.enableEntropy)
+    {
+        view.averageEntropy      = result.entropyY;
+        view.entropyDiff         = result.entropyDiff;
+        view.entropyEpsilon      = result.entropyEpsilon;
+        view.entropyPerBlock     = dataOrNullptr(result.entropyPerBlock);
+        view.entropyDiffPerBlock = dataOrNullptr(result.entropyDiffPerBlock);
+        if (cfg.enableEntropyChroma)
+        {
+            view.entropyU         = result.entropyU;
+            view.entropyV         = result.entropyV;
+            view.entropyUPerBlock = dataOrNullptr(result.entropyUPerBlock);
+            view.entropyVPerBlock = dataOrNullptr(result.entropyVPerBlock);
+        }
+    }
+    if (cfg.enableEdgeDensity)
+    {
+        view.averageEdgeDensity  = result.averageEdgeDensity;
+        view.edgeDensityPerBlock = dataOrNullptr(result.edgeDensityPerBlock);
+    }
+}
+
+} // namespace
+
 Analyzer::Analyzer(vca_param cfg)
 {
     this->cfg = cfg;
-    this->jobs.setMaximumQueueSize(5);
 
     const auto blockSize = this->cfg.blockSize;
     if (blockSize != 8 && blockSize != 16 && blockSize != 32)
@@ -64,23 +129,94 @@ Analyzer::Analyzer(vca_param cfg)
     }
     log(cfg, LogLevel::Info, "Using SIMD " + CpuSimdMapper.getName(this->cfg.cpuSimd));
 
-    if (cfg.nrFrameThreads == 0)
+    // The kernels are selected once here instead of for every block
+    this->primitives = setupPrimitives(blockSize, bitDepth, this->cfg.cpuSimd);
+
+    if (this->cfg.executor != nullptr)
+    {
+        this->executor           = static_cast<Executor *>(this->cfg.executor);
+        this->cfg.nrFrameThreads = this->executor->getNumberOfThreads();
+        log(cfg,
+            LogLevel::Info,
+            "Using shared executor with " + std::to_string(this->cfg.nrFrameThreads) + " threads");
+    }
+    else if (this->cfg.nrFrameThreads == 0)
+    {
+        this->cfg.nrFrameThreads = std::thread::hardware_concurrency();
+        log(cfg,
+            LogLevel::Info,
+            "Autodetect nr threads " + std::to_string(this->cfg.nrFrameThreads));
+    }
+
+    if (this->cfg.nrSliceThreads == 0)
+    {
+        this->cfg.nrSliceThreads = this->cfg.nrFrameThreads;
+        log(cfg,
+            LogLevel::Debug,
+            "Autodetect nr slices " + std::to_string(this->cfg.nrSliceThreads));
+    }
+    if (this->cfg.nrSliceThreads > 1)
+        log(cfg,
+            LogLevel::Info,
+            "Splitting each frame into " + std::to_string(this->cfg.nrSliceThreads) + " slices");
+
+    if (this->cfg.jobQueueSize == 0)
+        this->cfg.jobQueueSize = std::max(MIN_JOB_QUEUE_SIZE, this->cfg.nrFrameThreads);
+    this->jobs.setNumberOfWorkers(this->cfg.nrFrameThreads);
+    this->jobs.setMaximumQueueSize(this->cfg.jobQueueSize);
+
+    // The result queue is also the reorder window for frames that finish out of order. Every
+    // frame that was pushed and not finished yet must fit into it. Otherwise the workers could
+    // all wait for a slot that only an unfinished frame can free.
+    const auto minResultQueueSize = this->cfg.jobQueueSize + this->cfg.nrFrameThreads;
+    if (this->cfg.resultQueueSize == 0)
+    {
+        // All results are kept until they are pulled, so pushing never waits for a pull
+        const auto ringSize = std::max(UNBOUNDED_RESULT_RING_SIZE, minResultQueueSize);
+        this->results.setUnboundedQueueSize(ringSize);
+    }
+    else
+    {
+        if (this->cfg.resultQueueSize < minResultQueueSize)
+        {
+            this->cfg.resultQueueSize = minResultQueueSize;
+            log(cfg,
+                LogLevel::Warning,
+                "Raising result queue size to " + std::to_string(this->cfg.resultQueueSize));
+        }
+        this->results.setMaximumQueueSize(this->cfg.resultQueueSize);
+    }
+
+    if (this->executor != nullptr)
     {
-        cfg.nrFrameThreads = std::thread::hardware_concurrency();
-        log(cfg, LogLevel::Info, "Autodetect nr threads " + std::to_string(cfg.nrFrameThreads));
+        this->executor->attach(this);
+        return;
     }
 
-    auto nrThreads = cfg.nrFrameThreads;
+    auto nrThreads = this->cfg.nrFrameThreads;
     log(cfg, LogLevel::Info, "Starting " + std::to_string(nrThreads) + " threads");
     for (unsigned i = 0; i < nrThreads; i++)
     {
-        auto newThread = std::make_unique<ProcessingThread>(this->cfg, this->jobs, this->results, i);
+        auto newThread = std::make_unique<ProcessingThread>(this->cfg,
+                                                            this->primitives,
+                                                            this->jobs,
+                                                            this->results,
+                                                            i);
         this->threadPool.push_back(std::move(newThread));
     }
 }
 
 Analyzer::~Analyzer()
 {
+    if (this->executor != nullptr)
+    {
+        // Unblock the executor threads that wait to push a result of this analyzer
+        this->jobs.abort();
+        this->results.abort();
+        this->executor->detach(this);
+        return;
+    }
+
     for (auto &thread : this->threadPool)
         thread->abort();
     this->jobs.abort();
@@ -94,15 +230,59 @@ vca_result Analyzer::pushFrame(vca_frame *frame)
     if (!this->checkFrame(frame))
         return vca_result::VCA_ERROR;
 
+    this->queueFrame(frame);
+    return vca_result::VCA_OK;
+}
+
+vca_result Analyzer::tryPushFrame(vca_frame *frame)
+{
+    if (!this->checkFrame(frame))
+        return vca_result::VCA_ERROR;
+
+    // Only the pushing thread adds frames, so the queue can not become full in between
+    if (this->jobs.full())
+        return vca_result::VCA_BUSY;
+
+    this->queueFrame(frame);
+    return vca_result::VCA_OK;
+}
+
+void Analyzer::queueFrame(vca_frame *frame)
+{
+    auto frameResult          = this->resultPool.acquire();
+    frameResult->result.poc   = frame->stats.poc;
+    frameResult->result.jobID = this->frameCounter;
+    prepareResult(frameResult->result, this->cfg, frame);
+
+    // The workers take slices of consecutive block rows of the frame which are analyzed in
+    // parallel. Idle workers steal slices from the frames queued for the other workers.
+    const auto heightInBlocks  = getFrameSizeInBlocks(this->cfg.blockSize, frame->info).second;
+    const auto nrSlices        = std::clamp(this->cfg.nrSliceThreads, 1u, heightInBlocks);
+    const auto blockRowsPerJob = (heightInBlocks + nrSlices - 1) / nrSlices;
+    frameResult->nrBlockRowsPending = heightInBlocks;
+
     Job job;
-    job.frame = frame;
-    job.jobID = this->frameCounter;
-    // job.macroblockRange = TODO
+    job.frame                 = frame;
+    job.jobID                 = this->frameCounter;
+    job.macroblockRange.start = 0;
+    job.macroblockRange.end   = heightInBlocks;
+    job.frameResult           = frameResult;
 
-    this->jobs.waitAndPush(job);
+    this->jobs.waitAndPush(job, blockRowsPerJob);
     this->frameCounter++;
 
-    return vca_result::VCA_OK;
+    if (this->executor != nullptr)
+        this->executor->notifyWorkAvailable();
+}
+
+bool Analyzer::runNextJob(unsigned threadID)
+{
+    auto job = this->jobs.tryPop(threadID);
+    if (!job)
+        return false;
+
+    processJob(*job, this->cfg, this->primitives, this->results, threadID);
+    return true;
 }
 
 bool Analyzer::resultAvailable()
@@ -110,32 +290,48 @@ bool Analyzer::resultAvailable()
     return !this->results.empty();
 }
 
-vca_result Analyzer::pullResult(vca_frame_results *outputResult)
+SharedFrameResult *Analyzer::popResult()
 {
-    auto result = this->results.waitAndPop();
-    if (!result)
-        return vca_result::VCA_ERROR;
+    auto frameResult = this->results.waitAndPop();
+    if (!frameResult)
+        return nullptr;
+
+    auto result = &(*frameResult)->result;
 
     if (this->previousResult)
     {
+        const auto &previous = this->previousResult->result;
         if (this->cfg.enableDCTenergy)
         {
-            computeTextureSAD(*result, *this->previousResult);
-            if (this->previousResult->energyDiff > 0)
+            computeTextureSAD(*result, previous);
+            if (previous.energyDiff > 0)
             {
-                computeTextureEpsilon(*result, *this->previousResult);
+                computeTextureEpsilon(*result, previous);
             }
         }
         if (this->cfg.enableEntropy)
         {
-            computeEntropySAD(*result, *this->previousResult);
+            computeEntropySAD(*result, previous);
             auto entropyDiff     = result->entropyDiff;
-            auto entropyDiffPrev = this->previousResult->entropyDiff;
-            if (this->previousResult->entropyDiff > 0)
+            auto entropyDiffPrev = previous.entropyDiff;
+            if (previous.entropyDiff > 0)
                 result->entropyEpsilon = abs(entropyDiffPrev - entropyDiff);
         }
+        this->resultPool.release(this->previousResult);
     }
 
+    this->previousResult = *frameResult;
+    return *frameResult;
+}
+
+vca_result Analyzer::pullResult(vca_frame_results *outputResult)
+{
+    auto frameResult = this->popResult();
+    if (frameResult == nullptr)
+        return vca_result::VCA_ERROR;
+
+    auto result = &frameResult->result;
+
     outputResult->poc               = result->poc;
     outputResult->jobID             = result->jobID;
 
@@ -220,11 +416,35 @@ vca_result Analyzer::pullResult(vca_frame_results *outputResult)
                         result->edgeDensityPerBlock.size() * sizeof(double));
     }
 
-    this->previousResult = result;
+    return vca_result::VCA_OK;
+}
+
+vca_result Analyzer::pullResultRef(const vca_frame_results **outputResult)
+{
+    auto frameResult = this->popResult();
+    if (frameResult == nullptr)
+        return vca_result::VCA_ERROR;
+
+    fillResultView(frameResult->view, frameResult->result, this->cfg);
+    this->resultPool.lend(frameResult);
+    *outputResult = &frameResult->view;
 
     return vca_result::VCA_OK;
 }
 
+vca_result Analyzer::releaseResult(const vca_frame_results *result)
+{
+    auto frameResult = this->resultPool.takeBack(result);
+    if (frameResult == nullptr)
+    {
+        log(this->cfg, LogLevel::Error, "Released result is not lent out by the analyzer");
+        return vca_result::VCA_ERROR;
+    }
+
+    this->resultPool.release(frameResult);
+    return vca_result::VCA_OK;
+}
+
 bool Analyzer::checkFrame(const vca_frame *frame)
 {
     if (frame == nullptr)
@@ -260,6 +480,13 @@ bool Analyzer::checkFrame(const vca_frame *frame)
             return false;
         }
         this->frameInfo = info;
+
+        // The bit depth of the frames (e.g. from a y4m header) may differ from the configured one.
+        // No job was started yet so the threads do not use the kernels.
+        if (info.bitDepth != this->cfg.frameInfo.bitDepth)
+            this->primitives = setupPrimitives(this->cfg.blockSize,
+                                               info.bitDepth,
+                                               this->cfg.cpuSimd);
     }
 
     if (info.bitDepth != this->frameInfo->bitDepth || info.width != this->frameInfo->width
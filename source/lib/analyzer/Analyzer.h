@@ -18,8 +18,12 @@
 
 #pragma once
 
+#include <analyzer/Executor.h>
+#include <analyzer/JobScheduler.h>
 #include <analyzer/MultiThreadQueue.h>
+#include <analyzer/Primitives.h>
 #include <analyzer/ProcessingThread.h>
+#include <analyzer/ResultPool.h>
 #include <analyzer/common/common.h>
 #include <vcaLib.h>
 
@@ -37,21 +41,34 @@ public:
     ~Analyzer();
 
     vca_result pushFrame(vca_frame *frame);
+    vca_result tryPushFrame(vca_frame *frame);
     bool resultAvailable();
     vca_result pullResult(vca_frame_results *result);
+    vca_result pullResultRef(const vca_frame_results **result);
+    vca_result releaseResult(const vca_frame_results *result);
+
+    // Called by the threads of a shared executor. Analyze one job if there is one.
+    bool runNextJob(unsigned threadID);
 
 private:
     vca_param cfg{};
+    Primitives primitives;
     bool checkFrame(const vca_frame *frame);
+    void queueFrame(vca_frame *frame);
+    SharedFrameResult *popResult();
     std::optional<vca_frame_info> frameInfo;
     unsigned frameCounter{0};
 
     std::vector<std::unique_ptr<ProcessingThread>> threadPool;
+    // If set, the threads of the executor are used instead of the own thread pool
+    Executor *executor{};
 
-    MultiThreadQueue<Job> jobs;
-    MultiThreadQueue<Result> results;
+    ResultPool resultPool;
+    JobScheduler jobs;
+    MultiThreadQueue<SharedFrameResult *> results;
 
-    std::optional<Result> previousResult;
+    // Kept until the next frame was pulled for the SAD calculation
+    SharedFrameResult *previousResult{};
 };
 
 } // namespace vca
@@ -25,10 +25,14 @@
 
 #pragma once
 
+#include <analyzer/Primitives.h>
 #include <vcaLib.h>
 
 namespace vca {
 
+// With enableLowpassDCT, 16x16 and 32x32 blocks are downscaled by 2 before the transform. Then
+// only the (blockSize / 2) x (blockSize / 2) coefficients of the downscaled block are written
+// to the start of the coeffBuffer (with a stride of blockSize / 2).
 void performDCT(const unsigned blockSize,
                 const unsigned bitDepth,
                 int16_t *pixelBuffer,
@@ -36,4 +40,30 @@ void performDCT(const unsigned blockSize,
                 CpuSimd cpuSimd,
                 bool enableLowpassDCT);
 
+// The lowpass DCT of a 16x16 or 32x32 block that was already downscaled using performDownscale.
+// blockSum is the sum of all samples of the block before downscaling.
+void performLowpassDCT(const unsigned blockSize,
+                       const unsigned bitDepth,
+                       const int16_t *downscaledBlock,
+                       int32_t blockSum,
+                       int16_t *coeffBuffer,
+                       CpuSimd cpuSimd);
+
+// The same using the kernels of the table
+void performLowpassDCT(const Primitives &primitives,
+                       const unsigned blockSize,
+                       const int16_t *downscaledBlock,
+                       int32_t blockSum,
+                       int16_t *coeffBuffer);
+
+// The DCT of a block that needs no padding, read directly from the plane without staging it in a
+// pixel buffer. For a bitDepth of 8 the samples are bytes which are widened while they are read.
+// Otherwise the samples are 16 bit. There is no lowpass variant (see performDownscaleFromPlane).
+void performDCTFromPlane(const unsigned blockSize,
+                         const unsigned bitDepth,
+                         const uint8_t *src,
+                         unsigned srcStrideBytes,
+                         int16_t *coeffBuffer,
+                         CpuSimd cpuSimd);
+
 } // namespace vca
@@ -29,10 +29,13 @@
 
 namespace vca {
 
-typedef void (*dct_t)(const int16_t *src, int16_t *dst, intptr_t srcStride);
-
 void dct8_c(const int16_t *src, int16_t *dst, intptr_t srcStride, const unsigned bitDepth);
 void dct16_c(const int16_t *src, int16_t *dst, intptr_t srcStride, const unsigned bitDepth);
 void dct32_c(const int16_t *src, int16_t *dst, intptr_t srcStride, const unsigned bitDepth);
 
+// DCT of 8 bit samples. The samples are widened in the first butterfly stage.
+void dct8_c(const uint8_t *src, int16_t *dst, intptr_t srcStride);
+void dct16_c(const uint8_t *src, int16_t *dst, intptr_t srcStride);
+void dct32_c(const uint8_t *src, int16_t *dst, intptr_t srcStride);
+
 } // namespace vca
\ No newline at end of file
@@ -0,0 +1,93 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <analyzer/Downscale.h>
+
+#include <analyzer/Primitives.h>
+
+namespace vca {
+
+namespace {
+
+template<typename Sample>
+int32_t downscale(const Sample *src, intptr_t srcStride, unsigned blockSize, int16_t *dst)
+{
+    int32_t totalSum = 0;
+
+    const auto downscaledSize = blockSize / 2;
+    for (unsigned y = 0; y < downscaledSize; y++)
+    {
+        const auto row0 = src + 2 * y * srcStride;
+        const auto row1 = row0 + srcStride;
+        for (unsigned x = 0; x < downscaledSize; x++)
+        {
+            const int sum = row0[2 * x] + row0[2 * x + 1] + row1[2 * x] + row1[2 * x + 1];
+            dst[y * downscaledSize + x] = static_cast<int16_t>(sum >> 2);
+            totalSum += sum;
+        }
+    }
+
+    return totalSum;
+}
+
+} // namespace
+
+template<unsigned BlockSize>
+int32_t downscale_c(const int16_t *src, intptr_t srcStride, unsigned /* blockSize */, int16_t *dst)
+{
+    return downscale(src, srcStride, BlockSize, dst);
+}
+
+template<unsigned BlockSize>
+int32_t downscale_8bit_c(const uint8_t *src,
+                         intptr_t srcStride,
+                         unsigned /* blockSize */,
+                         int16_t *dst)
+{
+    return downscale(src, srcStride, BlockSize, dst);
+}
+
+template int32_t downscale_c<8>(const int16_t *, intptr_t, unsigned, int16_t *);
+template int32_t downscale_c<16>(const int16_t *, intptr_t, unsigned, int16_t *);
+template int32_t downscale_c<32>(const int16_t *, intptr_t, unsigned, int16_t *);
+template int32_t downscale_8bit_c<8>(const uint8_t *, intptr_t, unsigned, int16_t *);
+template int32_t downscale_8bit_c<16>(const uint8_t *, intptr_t, unsigned, int16_t *);
+template int32_t downscale_8bit_c<32>(const uint8_t *, intptr_t, unsigned, int16_t *);
+
+int32_t performDownscale(const unsigned blockSize,
+                         const int16_t *pixelBuffer,
+                         int16_t *dst,
+                         CpuSimd cpuSimd)
+{
+    // Downscaling int16 samples does not depend on the bit depth
+    const auto primitives = setupPrimitives(blockSize, 8, cpuSimd);
+    return primitives.downscale(pixelBuffer, blockSize, blockSize, dst);
+}
+
+int32_t performDownscaleFromPlane(const unsigned blockSize,
+                                  const unsigned bitDepth,
+                                  const uint8_t *src,
+                                  unsigned srcStrideBytes,
+                                  int16_t *dst,
+                                  CpuSimd cpuSimd)
+{
+    const auto primitives = setupPrimitives(blockSize, bitDepth, cpuSimd);
+    return primitives.downscaleFromPlane(src, srcStrideBytes, blockSize, dst);
+}
+
+} // namespace vca
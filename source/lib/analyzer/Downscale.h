@@ -0,0 +1,48 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vcaLib.h>
+
+namespace vca {
+
+// C versions of the 2x2 downscaling kernels. srcStride is given in samples. These are compiled for
+// each block size. blockSize must be equal to BlockSize.
+template<unsigned BlockSize>
+int32_t downscale_c(const int16_t *src, intptr_t srcStride, unsigned blockSize, int16_t *dst);
+template<unsigned BlockSize>
+int32_t downscale_8bit_c(const uint8_t *src, intptr_t srcStride, unsigned blockSize, int16_t *dst);
+
+// Downscale a block by averaging 2x2 samples into the (blockSize / 2) x (blockSize / 2) block
+// dst. Returns the sum of all samples of the source block.
+int32_t performDownscale(const unsigned blockSize,
+                         const int16_t *pixelBuffer,
+                         int16_t *dst,
+                         CpuSimd cpuSimd);
+
+// The same as performDownscale but the samples are read directly from the plane without
+// staging them in a pixel buffer. 8 bit samples are widened while they are read.
+int32_t performDownscaleFromPlane(const unsigned blockSize,
+                                  const unsigned bitDepth,
+                                  const uint8_t *src,
+                                  unsigned srcStrideBytes,
+                                  int16_t *dst,
+                                  CpuSimd cpuSimd);
+
+} // namespace vca
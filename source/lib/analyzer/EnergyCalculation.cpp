@@ -115,569 +115,455 @@ static const int16_t weights_dct32[1024] = {
     120, 124, 128, 133, 138, 144, 150, 157, 164, 172, 181, 191, 201, 213, 225, 239, 255,
 };
 
-static const double E_norm_factor = 90;
-static const double h_norm_factor = 18;
-
-uint32_t calculateWeightedCoeffSum(unsigned blockSize, int16_t *coeffBuffer, bool enableLowpassDCT)
+// The top left quadrant of a weight table. These are the weights of the compact coefficients of
+// the lowpass DCT.
+template<unsigned BlockSize>
+struct LowpassWeights
 {
-    uint32_t weightedSum = 0;
+    static constexpr unsigned SIZE = BlockSize / 2;
 
-    auto weightFactorMatrix = weights_dct32;
-    switch (blockSize)
+    LowpassWeights(const int16_t *weights)
     {
-        case 32:
-            weightFactorMatrix = weights_dct32;
-            break;
-        case 16:
-            weightFactorMatrix = weights_dct16;
-            break;
-        case 8:
-            weightFactorMatrix = weights_dct8;
-            break;
+        for (unsigned y = 0; y < SIZE; y++)
+            for (unsigned x = 0; x < SIZE; x++)
+                this->values[y * SIZE + x] = weights[y * BlockSize + x];
     }
 
-    for (unsigned i = 0; i < blockSize * blockSize; i++)
-    {
-        auto weightedCoeff = (uint32_t)((weightFactorMatrix[i] * std::abs(coeffBuffer[i])) >> 8);
-        weightedSum += weightedCoeff;
-    }
-    if (blockSize >= 16 && enableLowpassDCT)
+    int16_t values[SIZE * SIZE];
+};
+
+static const LowpassWeights<16> weights_dct16_lowpass(weights_dct16);
+static const LowpassWeights<32> weights_dct32_lowpass(weights_dct32);
+
+static const double E_norm_factor = 90;
+static const double h_norm_factor = 18;
+
+template<unsigned BlockSize>
+uint32_t calculateWeightedCoeffSum(int16_t *coeffBuffer,
+                                   bool enableLowpassDCT,
+                                   const vca::Primitives &primitives)
+{
+    // The lowpass DCT only outputs the compact top left quadrant of the coefficients
+    const auto isLowpass = BlockSize >= 16 && enableLowpassDCT;
+
+    const int16_t *weightFactorMatrix = weights_dct8;
+    if constexpr (BlockSize == 32)
+        weightFactorMatrix = isLowpass ? weights_dct32_lowpass.values : weights_dct32;
+    else if constexpr (BlockSize == 16)
+        weightFactorMatrix = isLowpass ? weights_dct16_lowpass.values : weights_dct16;
+
+    const auto size  = isLowpass ? BlockSize / 2 : BlockSize;
+    auto weightedSum = primitives.weightedCoeffSum(coeffBuffer, weightFactorMatrix, size, size);
+    if (isLowpass)
         weightedSum *= 2;
 
     return weightedSum;
 }
 
-void copyPixelValuesToBufferNoPadding(unsigned bitDepth,
-                                      unsigned blockSize,
-                                      uint8_t *srcData,
-                                      unsigned srcStrideBytes,
-                                      int16_t *buffer)
+// Output pointers for the per block values of one plane. Features with a nullptr are skipped.
+struct PlaneFeatureOutput
 {
-    if (bitDepth == 8)
-    {
-        auto *__restrict src = srcData;
-        for (unsigned y = 0; y < blockSize; y++, src += srcStrideBytes)
-            for (unsigned x = 0; x < blockSize; x++)
-                *(buffer++) = int16_t(src[x]);
-    }
-    else
+    uint32_t *brightnessPerBlock{};
+    uint32_t *energyPerBlock{};
+    double *entropyPerBlock{};
+    double *edgeDensityPerBlock{};
+};
+
+// Analyze the given block rows of one plane. A block is copied into the int16 pixel buffer at
+// most once and all enabled features are calculated from it while it is still in the cache.
+template<unsigned BlockSize, unsigned BitDepth>
+void computePlaneFeatures(uint8_t *src,
+                          unsigned srcStride,
+                          unsigned width,
+                          unsigned height,
+                          vca::MacroblockRange blockRows,
+                          const vca_param &cfg,
+                          const vca::Primitives &primitives,
+                          PlaneFeatureOutput output)
+{
+    constexpr auto bytesPerPixel = (BitDepth > 8) ? 2u : 1u;
+
+    auto [widthInBlocks, heightInBlock] = vca::getChromaFrameSizeInBlocks(BlockSize, width, height);
+    auto widthInPixels                  = widthInBlocks * BlockSize;
+
+    // Blocks that need padding are copied to a temporary buffer which has one int16_t value per
+    // sample. The same is done for all blocks if the entropy or edge density needs the full block.
+    // Otherwise the DCT and downscaling read the samples directly from the plane (8 bit samples
+    // are widened while they are read).
+
+    ALIGN_VAR_32(int16_t, pixelBuffer[BlockSize * BlockSize]);
+    ALIGN_VAR_32(int16_t, downscaledBuffer[BlockSize * BlockSize / 4]);
+    ALIGN_VAR_32(int16_t, coeffBuffer[BlockSize * BlockSize]);
+
+    // In lowpass mode the DCT of 16x16 and 32x32 blocks and the entropy work on the block
+    // downscaled by 2. It is only downscaled once for both.
+    const auto lowpassDCT       = cfg.enableLowpass && BlockSize >= 16 && output.energyPerBlock;
+    const auto lowpassEntropy   = cfg.enableLowpass && output.entropyPerBlock;
+    const auto needsPixelBuffer = output.edgeDensityPerBlock
+                                  || (output.entropyPerBlock && !lowpassEntropy);
+
+    auto blockIndex = blockRows.start * widthInBlocks;
+    for (unsigned blockY = blockRows.start * BlockSize; blockY < blockRows.end * BlockSize;
+         blockY += BlockSize)
     {
-        auto *__restrict src      = reinterpret_cast<uint16_t *>(srcData);
-        const auto nrBytesPerLine = blockSize * 2;
-        for (unsigned y = 0; y < blockSize; ++y)
+        auto paddingBottom = std::max(int(blockY + BlockSize) - int(height), 0);
+        for (unsigned blockX = 0; blockX < widthInPixels; blockX += BlockSize)
         {
-            std::memcpy(buffer, src, nrBytesPerLine);
-            src += srcStrideBytes / 2;
-            buffer += blockSize;
+            auto paddingRight = std::max(int(blockX + BlockSize) - int(width), 0);
+            auto blockOffsetBytes = blockX * bytesPerPixel + (blockY * srcStride);
+
+            const auto readFromPlane = paddingRight == 0 && paddingBottom == 0
+                                       && !needsPixelBuffer;
+            if (!readFromPlane)
+                primitives.copyBlock(src + blockOffsetBytes,
+                                     srcStride,
+                                     BlockSize,
+                                     unsigned(paddingRight),
+                                     unsigned(paddingBottom),
+                                     pixelBuffer);
+
+            int32_t blockSum = 0;
+            if ((lowpassDCT || lowpassEntropy) && readFromPlane)
+                blockSum = primitives.downscaleFromPlane(src + blockOffsetBytes,
+                                                         srcStride,
+                                                         BlockSize,
+                                                         downscaledBuffer);
+            else if (lowpassDCT || lowpassEntropy)
+                blockSum = primitives.downscale(pixelBuffer,
+                                                BlockSize,
+                                                BlockSize,
+                                                downscaledBuffer);
+
+            if (lowpassDCT)
+                vca::performLowpassDCT(primitives,
+                                       BlockSize,
+                                       downscaledBuffer,
+                                       blockSum,
+                                       coeffBuffer);
+            else if (output.energyPerBlock && readFromPlane)
+                primitives.dctFromPlane(src + blockOffsetBytes, coeffBuffer, srcStride);
+            else if (output.energyPerBlock)
+                primitives.dct(pixelBuffer, coeffBuffer, BlockSize);
+
+            if (output.energyPerBlock)
+            {
+                output.brightnessPerBlock[blockIndex] = uint32_t(sqrt(coeffBuffer[0]));
+                output.energyPerBlock[blockIndex]     = calculateWeightedCoeffSum<BlockSize>(
+                    coeffBuffer,
+                    cfg.enableLowpass,
+                    primitives);
+            }
+            if (lowpassEntropy)
+                output.entropyPerBlock[blockIndex] = primitives.entropy(downscaledBuffer,
+                                                                        BlockSize / 2);
+            else if (output.entropyPerBlock)
+                output.entropyPerBlock[blockIndex] = primitives.entropy(pixelBuffer, BlockSize);
+            if (output.edgeDensityPerBlock)
+                output.edgeDensityPerBlock[blockIndex] = vca::performEdgeDensity(primitives,
+                                                                                 BlockSize,
+                                                                                 BitDepth,
+                                                                                 pixelBuffer);
+            blockIndex++;
         }
     }
 }
 
-void copyPixelValuesToBufferWithPadding8Bit(unsigned blockSize,
-                                            uint8_t *srcData,
-                                            unsigned srcStrideBytes,
-                                            int16_t *buffer,
-                                            unsigned paddingRight,
-                                            unsigned paddingBottom)
-{
-    auto *__restrict src = srcData;
+} // namespace
 
-    unsigned y          = 0;
-    auto bufferLastLine = buffer;
-    for (; y < blockSize - paddingBottom; y++, src += srcStrideBytes)
-    {
-        unsigned x     = 0;
-        bufferLastLine = buffer;
-        for (; x < blockSize - paddingRight; x++)
-            *(buffer++) = static_cast<int16_t>(src[x]);
-        const auto lastValue = static_cast<int16_t>(src[x]);
-        for (; x < blockSize; x++)
-            *(buffer++) = lastValue;
-    }
-    for (; y < blockSize; y++)
+namespace vca {
+
+uint32_t weighted_coeff_sum_c(const int16_t *coeff,
+                              const int16_t *weights,
+                              unsigned stride,
+                              unsigned size)
+{
+    uint32_t weightedSum = 0;
+    for (unsigned y = 0; y < size; y++)
     {
-        for (unsigned x = 0; x < blockSize; x++)
-            *(buffer++) = (bufferLastLine[x]);
+        for (unsigned x = 0; x < size; x++)
+        {
+            const auto i       = y * stride + x;
+            auto weightedCoeff = (uint32_t)((weights[i] * std::abs(coeff[i])) >> 8);
+            weightedSum += weightedCoeff;
+        }
     }
+    return weightedSum;
 }
 
-void copyPixelValuesToBufferWithPaddingHighBitDepth(unsigned blockSize,
-                                                    uint8_t *srcData,
-                                                    unsigned srcStrideBytes,
-                                                    int16_t *buffer,
-                                                    unsigned paddingRight,
-                                                    unsigned paddingBottom)
+template<unsigned BlockSize>
+void copy_block_c(const int16_t *src,
+                  intptr_t srcStride,
+                  unsigned /* blockSize */,
+                  unsigned paddingRight,
+                  unsigned paddingBottom,
+                  int16_t *dst)
 {
-    auto *__restrict src = reinterpret_cast<uint16_t *>(srcData);
-
-    unsigned y          = 0;
-    auto bufferLastLine = buffer;
-    for (; y < blockSize - paddingBottom; y++)
-    {
-        unsigned x     = 0;
-        bufferLastLine = buffer;
-
-        const auto nrValuesToCopy = blockSize - paddingRight;
-        const auto nrBytesToCopy  = nrValuesToCopy * 2;
-        std::memcpy(buffer, src, nrBytesToCopy);
+    const auto nrValuesToCopy = BlockSize - paddingRight;
+    const auto lastLine       = BlockSize - paddingBottom - 1;
 
-        const auto lastValue = src[nrValuesToCopy - 1];
-        for (unsigned x = nrValuesToCopy; x < blockSize; x++)
-            buffer[x] = lastValue;
-
-        buffer += blockSize;
-        src += srcStrideBytes / 2;
-    }
-    for (; y < blockSize; y++)
+    for (unsigned y = 0; y <= lastLine; y++, src += srcStride)
     {
-        const auto nrBytesToCopy = blockSize * 2;
-        std::memcpy(buffer, bufferLastLine, nrBytesToCopy);
-        buffer += blockSize;
+        std::memcpy(dst + y * BlockSize, src, nrValuesToCopy * sizeof(int16_t));
+        for (unsigned x = nrValuesToCopy; x < BlockSize; x++)
+            dst[y * BlockSize + x] = src[nrValuesToCopy - 1];
     }
+    for (unsigned y = lastLine + 1; y < BlockSize; y++)
+        std::memcpy(dst + y * BlockSize, dst + lastLine * BlockSize, BlockSize * sizeof(int16_t));
 }
 
-void copyPixelValuesToBuffer(unsigned bitDepth,
-                             unsigned blockOffsetBytes,
-                             unsigned blockSize,
-                             uint8_t *srcData,
-                             unsigned srcStrideBytes,
-                             int16_t *buffer,
-                             unsigned paddingRight,
-                             unsigned paddingBottom)
+template<unsigned BlockSize>
+void copy_block_8bit_c(const uint8_t *src,
+                       intptr_t srcStride,
+                       unsigned /* blockSize */,
+                       unsigned paddingRight,
+                       unsigned paddingBottom,
+                       int16_t *dst)
 {
-    if (bitDepth < 8 || bitDepth > 16)
-        throw std::invalid_argument("Invalid bit depth " + std::to_string(bitDepth));
+    const auto nrValuesToCopy = BlockSize - paddingRight;
+    const auto lastLine       = BlockSize - paddingBottom - 1;
 
-    srcData += blockOffsetBytes;
-
-    if (paddingRight == 0 && paddingBottom == 0)
-        copyPixelValuesToBufferNoPadding(bitDepth, blockSize, srcData, srcStrideBytes, buffer);
-    else
+    for (unsigned y = 0; y <= lastLine; y++, src += srcStride)
     {
-        if (bitDepth == 8)
-            copyPixelValuesToBufferWithPadding8Bit(blockSize,
-                                                   srcData,
-                                                   srcStrideBytes,
-                                                   buffer,
-                                                   paddingRight,
-                                                   paddingBottom);
-        else if (bitDepth > 8 && bitDepth <= 16)
-            copyPixelValuesToBufferWithPaddingHighBitDepth(blockSize,
-                                                           srcData,
-                                                           srcStrideBytes,
-                                                           buffer,
-                                                           paddingRight,
-                                                           paddingBottom);
+        for (unsigned x = 0; x < nrValuesToCopy; x++)
+            dst[y * BlockSize + x] = int16_t(src[x]);
+        for (unsigned x = nrValuesToCopy; x < BlockSize; x++)
+            dst[y * BlockSize + x] = int16_t(src[nrValuesToCopy - 1]);
     }
+    for (unsigned y = lastLine + 1; y < BlockSize; y++)
+        std::memcpy(dst + y * BlockSize, dst + lastLine * BlockSize, BlockSize * sizeof(int16_t));
 }
 
-} // namespace
-
-namespace vca {
-
-void computeWeightedDCTEnergy(const Job &job,
-                              Result &result,
-                              const unsigned blockSize,
-                              CpuSimd cpuSimd,
-                              bool enableChroma,
-                              bool enableLowpass)
+template<unsigned BlockSize, unsigned BitDepth>
+void computeFeatures(const Job &job,
+                     Result &result,
+                     const vca_param &cfg,
+                     const Primitives &primitives)
 {
     const auto frame = job.frame;
     if (frame == nullptr)
         throw std::invalid_argument("Invalid frame pointer");
 
-    const auto bitDepth      = frame->info.bitDepth;
-    const auto bytesPerPixel = (bitDepth > 8) ? 2 : 1;
+    constexpr auto bytesPerPixel = (BitDepth > 8) ? 2 : 1;
 
-    auto src       = frame->planes[0];
-    auto srcStride = frame->stride[0];
+    PlaneFeatureOutput lumaOutput;
+    if (cfg.enableDCTenergy)
+    {
+        lumaOutput.brightnessPerBlock = result.brightnessPerBlock.data();
+        lumaOutput.energyPerBlock     = result.energyPerBlock.data();
+    }
+    if (cfg.enableEntropy)
+        lumaOutput.entropyPerBlock = result.entropyPerBlock.data();
+    if (cfg.enableEdgeDensity)
+        lumaOutput.edgeDensityPerBlock = result.edgeDensityPerBlock.data();
+
+    computePlaneFeatures<BlockSize, BitDepth>(frame->planes[0],
+                                              frame->stride[0],
+                                              frame->info.width,
+                                              frame->info.height,
+                                              job.macroblockRange,
+                                              cfg,
+                                              primitives,
+                                              lumaOutput);
+
+    const auto enableEnergyChroma  = cfg.enableDCTenergy && cfg.enableEnergyChroma;
+    const auto enableEntropyChroma = cfg.enableEntropy && cfg.enableEntropyChroma;
+    if (!enableEnergyChroma && !enableEntropyChroma)
+        return;
+
+    const auto srcUStride = frame->stride[1];
+    const auto srcUHeight = frame->height[1];
+    const auto srcUWidth  = srcUStride / bytesPerPixel;
+
+    const auto heightInBlock  = getFrameSizeInBlocks(BlockSize, frame->info).second;
+    const auto heightInBlockC = getChromaFrameSizeInBlocks(BlockSize, srcUWidth, srcUHeight).second;
+    const auto blockRowsC
+        = getChromaBlockRowRange(job.macroblockRange, heightInBlock, heightInBlockC);
+
+    PlaneFeatureOutput uOutput;
+    PlaneFeatureOutput vOutput;
+    if (enableEnergyChroma)
+    {
+        uOutput.brightnessPerBlock = result.averageUPerBlock.data();
+        uOutput.energyPerBlock     = result.energyUPerBlock.data();
+        vOutput.brightnessPerBlock = result.averageVPerBlock.data();
+        vOutput.energyPerBlock     = result.energyVPerBlock.data();
+    }
+    if (enableEntropyChroma)
+    {
+        uOutput.entropyPerBlock = result.entropyUPerBlock.data();
+        vOutput.entropyPerBlock = result.entropyVPerBlock.data();
+    }
 
-    auto [widthInBlocks, heightInBlock] = getFrameSizeInBlocks(blockSize, frame->info);
-    auto totalNumberBlocks              = widthInBlocks * heightInBlock;
-    auto widthInPixels                  = widthInBlocks * blockSize;
-    auto heightInPixels                 = heightInBlock * blockSize;
+    computePlaneFeatures<BlockSize, BitDepth>(frame->planes[1],
+                                              srcUStride,
+                                              srcUWidth,
+                                              srcUHeight,
+                                              blockRowsC,
+                                              cfg,
+                                              primitives,
+                                              uOutput);
+    computePlaneFeatures<BlockSize, BitDepth>(frame->planes[2],
+                                              srcUStride,
+                                              srcUWidth,
+                                              srcUHeight,
+                                              blockRowsC,
+                                              cfg,
+                                              primitives,
+                                              vOutput);
+}
 
-    if (result.brightnessPerBlock.size() < totalNumberBlocks)
-        result.brightnessPerBlock.resize(totalNumberBlocks);
-    if (result.energyPerBlock.size() < totalNumberBlocks)
-        result.energyPerBlock.resize(totalNumberBlocks);
+// The block sizes and bit depths that Primitives::computeFeatures is resolved for
+#define INSTANTIATE_FOR_BLOCK_SIZE(blockSize)                                                      \
+    template void copy_block_c<blockSize>(const int16_t *,                                         \
+                                          intptr_t,                                                \
+                                          unsigned,                                                \
+                                          unsigned,                                                \
+                                          unsigned,                                                \
+                                          int16_t *);                                              \
+    template void copy_block_8bit_c<blockSize>(const uint8_t *,                                    \
+                                               intptr_t,                                           \
+                                               unsigned,                                           \
+                                               unsigned,                                           \
+                                               unsigned,                                           \
+                                               int16_t *);                                         \
+    template void computeFeatures<blockSize, 8>(const Job &,                                       \
+                                                Result &,                                          \
+                                                const vca_param &,                                 \
+                                                const Primitives &);                               \
+    template void computeFeatures<blockSize, 10>(const Job &,                                      \
+                                                 Result &,                                         \
+                                                 const vca_param &,                                \
+                                                 const Primitives &);                              \
+    template void computeFeatures<blockSize, 12>(const Job &,                                      \
+                                                 Result &,                                         \
+                                                 const vca_param &,                                \
+                                                 const Primitives &);
+
+INSTANTIATE_FOR_BLOCK_SIZE(8)
+INSTANTIATE_FOR_BLOCK_SIZE(16)
+INSTANTIATE_FOR_BLOCK_SIZE(32)
+
+#undef INSTANTIATE_FOR_BLOCK_SIZE
+
+void prepareResult(Result &result, const vca_param &cfg, const vca_frame *frame)
+{
+    // Results are reused. These are only set if there is a previous frame.
+    result.energyDiff     = 0.0;
+    result.energyEpsilon  = 0.0;
+    result.entropyDiff    = 0.0;
+    result.entropyEpsilon = 0.0;
 
-    // First, we will copy the source to a temporary buffer which has one int16_t value
-    // per sample.
-    //   - This may only be needed for 8 bit values. For 16 bit values we could also
-    //     perform this directly from the source buffer. However, we should check the
-    //     performance of that approach (i.e. the buffer may not be aligned)
+    const auto blockSize                = cfg.blockSize;
+    auto [widthInBlocks, heightInBlock] = getFrameSizeInBlocks(blockSize, frame->info);
+    const auto totalNumberBlocks        = widthInBlocks * heightInBlock;
 
-    ALIGN_VAR_32(int16_t, pixelBuffer[32 * 32]);
-    ALIGN_VAR_32(int16_t, coeffBuffer[32 * 32]);
+    const auto bytesPerPixel = (frame->info.bitDepth > 8) ? 2 : 1;
+    const auto srcUWidth     = frame->stride[1] / bytesPerPixel;
+    auto [widthInBlocksC, heightInBlockC] = getChromaFrameSizeInBlocks(blockSize,
+                                                                       srcUWidth,
+                                                                       frame->height[1]);
+    const auto totalNumberBlocksC         = widthInBlocksC * heightInBlockC;
 
-    auto blockIndex          = 0u;
-    uint32_t frameBrightness = 0;
-    uint32_t frameTexture    = 0;
-    for (unsigned blockY = 0; blockY < heightInPixels; blockY += blockSize)
+    if (cfg.enableDCTenergy)
     {
-        auto paddingBottom = std::max(int(blockY + blockSize) - int(frame->info.height), 0);
-        for (unsigned blockX = 0; blockX < widthInPixels; blockX += blockSize)
+        result.brightnessPerBlock.resize(totalNumberBlocks);
+        result.energyPerBlock.resize(totalNumberBlocks);
+        if (cfg.enableEnergyChroma)
         {
-            auto paddingRight = std::max(int(blockX + blockSize) - int(frame->info.width), 0);
-            auto blockOffsetLumaBytes = blockX * bytesPerPixel + (blockY * srcStride);
-
-            copyPixelValuesToBuffer(bitDepth,
-                                    blockOffsetLumaBytes,
-                                    blockSize,
-                                    src,
-                                    srcStride,
-                                    pixelBuffer,
-                                    unsigned(paddingRight),
-                                    unsigned(paddingBottom));
-
-            performDCT(blockSize,
-                       bitDepth,
-                       pixelBuffer,
-                       coeffBuffer,
-                       cpuSimd,
-                       enableLowpass);
-
-            result.brightnessPerBlock[blockIndex] = uint32_t(sqrt(coeffBuffer[0]));
-            result.energyPerBlock[blockIndex]     = calculateWeightedCoeffSum(blockSize,
-                                                                              coeffBuffer,
-                                                                              enableLowpass);
-            frameBrightness += result.brightnessPerBlock[blockIndex];
-            frameTexture += result.energyPerBlock[blockIndex];
-
-            blockIndex++;
-        }
-    }
-
-    result.averageBrightness = uint32_t((double) (frameBrightness) / totalNumberBlocks);
-    result.averageEnergy = uint32_t((double) (frameTexture) / (totalNumberBlocks * E_norm_factor));
-
-    if (enableChroma)
-    {
-        const auto srcU       = frame->planes[1];
-        const auto srcV       = frame->planes[2];
-        const auto srcUStride = frame->stride[1];
-        const auto srcUHeight = frame->height[1];
-        const auto srcUWidth  = srcUStride / bytesPerPixel;
-
-        auto [widthInBlocksC, heightInBlockC] = getChromaFrameSizeInBlocks(blockSize,
-                                                                           srcUWidth,
-                                                                           srcUHeight);
-        const auto totalNumberBlocksC         = widthInBlocksC * heightInBlockC;
-        const auto widthInPixelsC             = widthInBlocksC * blockSize;
-        const auto heightInPixelsC            = heightInBlockC * blockSize;
-
-        if (result.averageUPerBlock.size() < totalNumberBlocksC)
             result.averageUPerBlock.resize(totalNumberBlocksC);
-        if (result.averageVPerBlock.size() < totalNumberBlocksC)
             result.averageVPerBlock.resize(totalNumberBlocksC);
-        if (result.energyUPerBlock.size() < totalNumberBlocksC)
             result.energyUPerBlock.resize(totalNumberBlocksC);
-        if (result.energyVPerBlock.size() < totalNumberBlocksC)
             result.energyVPerBlock.resize(totalNumberBlocksC);
-
-        ALIGN_VAR_32(int16_t, pixelBufferC[32 * 32]);
-        ALIGN_VAR_32(int16_t, coeffBufferC[32 * 32]);
-
-        auto blockIndexC      = 0u;
-        uint32_t frameU       = 0;
-        uint32_t frameV       = 0;
-        uint32_t frameEnergyU = 0;
-        uint32_t frameEnergyV = 0;
-        for (unsigned blockY = 0; blockY < heightInPixelsC; blockY += blockSize)
-        {
-            auto paddingBottom = std::max(int(blockY + blockSize) - int(srcUHeight), 0);
-            for (unsigned blockX = 0; blockX < widthInPixelsC; blockX += blockSize)
-            {
-                auto paddingRight = std::max(int(blockX + blockSize) - int(srcUStride), 0);
-                auto blockOffsetChromaBytes = blockX * bytesPerPixel + (blockY * srcUStride);
-
-                copyPixelValuesToBuffer(bitDepth,
-                                        blockOffsetChromaBytes,
-                                        blockSize,
-                                        srcU,
-                                        srcUStride,
-                                        pixelBufferC,
-                                        unsigned(paddingRight),
-                                        unsigned(paddingBottom));
-
-                performDCT(blockSize,
-                           bitDepth,
-                           pixelBufferC,
-                           coeffBufferC,
-                           cpuSimd,
-                           enableLowpass);
-
-                result.averageUPerBlock[blockIndexC] = uint32_t(sqrt(coeffBufferC[0]));
-                result.energyUPerBlock[blockIndexC]  = calculateWeightedCoeffSum(blockSize,
-                                                                                 coeffBufferC,
-                                                                                 enableLowpass);
-                frameU += result.averageUPerBlock[blockIndexC];
-                frameEnergyU += result.energyUPerBlock[blockIndexC];
-
-                blockIndexC++;
-            }
-        }
-        result.averageU = uint32_t((double) (frameU) / totalNumberBlocksC);
-        result.energyU  = uint32_t((double) (frameEnergyU) / (totalNumberBlocksC * E_norm_factor));
-
-        blockIndexC = 0u;
-        for (unsigned blockY = 0; blockY < heightInPixelsC; blockY += blockSize)
-        {
-            auto paddingBottom = std::max(int(blockY + blockSize) - int(srcUHeight), 0);
-            for (unsigned blockX = 0; blockX < widthInPixelsC; blockX += blockSize)
-            {
-                auto paddingRight = std::max(int(blockX + blockSize) - int(srcUStride), 0);
-                auto blockOffsetChromaBytes = blockX * bytesPerPixel + (blockY * srcUStride);
-
-                copyPixelValuesToBuffer(bitDepth,
-                                        blockOffsetChromaBytes,
-                                        blockSize,
-                                        srcV,
-                                        srcUStride,
-                                        pixelBufferC,
-                                        unsigned(paddingRight),
-                                        unsigned(paddingBottom));
-
-                performDCT(blockSize,
-                           bitDepth,
-                           pixelBufferC,
-                           coeffBufferC,
-                           cpuSimd,
-                           enableLowpass);
-
-                result.averageVPerBlock[blockIndexC] = uint32_t(sqrt(coeffBufferC[0]));
-                result.energyVPerBlock[blockIndexC]  = calculateWeightedCoeffSum(blockSize,
-                                                                                coeffBufferC,
-                                                                                enableLowpass);
-                frameV += result.averageVPerBlock[blockIndexC];
-                frameEnergyV += result.energyVPerBlock[blockIndexC];
-
-                blockIndexC++;
-            }
         }
-        result.averageV = uint32_t((double) (frameV) / totalNumberBlocksC);
-        result.energyV  = uint32_t((double) (frameEnergyV) / (totalNumberBlocksC * E_norm_factor));
     }
-}
-
-void computeEdgeDensity(const Job &job,
-                        Result &result,
-                        const unsigned blockSize,
-                        CpuSimd cpuSimd,
-                        bool enableLowpass)
-{
-    const auto frame = job.frame;
-    if (frame == nullptr)
-        throw std::invalid_argument("Invalid frame pointer");
-
-    const auto bitDepth      = frame->info.bitDepth;
-    const auto bytesPerPixel = (bitDepth > 8) ? 2 : 1;
-
-    auto src       = frame->planes[0];
-    auto srcStride = frame->stride[0];
-
-    auto [widthInBlocks, heightInBlock] = getFrameSizeInBlocks(blockSize, frame->info);
-    auto totalNumberBlocks              = widthInBlocks * heightInBlock;
-    auto widthInPixels                  = widthInBlocks * blockSize;
-    auto heightInPixels                 = heightInBlock * blockSize;
-
-        if (result.edgeDensityPerBlock.size() < totalNumberBlocks)
-        result.edgeDensityPerBlock.resize(totalNumberBlocks);
-
-    // First, we will copy the source to a temporary buffer which has one int16_t value
-    // per sample.
-    //   - This may only be needed for 8 bit values. For 16 bit values we could also
-    //     perform this directly from the source buffer. However, we should check the
-    //     performance of that approach (i.e. the buffer may not be aligned)
-
-    ALIGN_VAR_32(int16_t, pixelBuffer[32 * 32]);
-
-    auto blockIndex     = 0u;
-    double frameEdgeDensity = 0;
-    for (unsigned blockY = 0; blockY < heightInPixels; blockY += blockSize)
+    if (cfg.enableEntropy)
     {
-        auto paddingBottom = std::max(int(blockY + blockSize) - int(frame->info.height), 0);
-        for (unsigned blockX = 0; blockX < widthInPixels; blockX += blockSize)
+        result.entropyPerBlock.resize(totalNumberBlocks);
+        if (cfg.enableEntropyChroma)
         {
-            auto paddingRight = std::max(int(blockX + blockSize) - int(frame->info.width), 0);
-            auto blockOffsetLumaBytes = blockX * bytesPerPixel + (blockY * srcStride);
-
-            copyPixelValuesToBuffer(bitDepth,
-                                    blockOffsetLumaBytes,
-                                    blockSize,
-                                    src,
-                                    srcStride,
-                                    pixelBuffer,
-                                    unsigned(paddingRight),
-                                    unsigned(paddingBottom));
-
-            result.edgeDensityPerBlock[blockIndex] = performEdgeDensity(blockSize,
-                                                                        bitDepth,
-                                                                        pixelBuffer,
-                                                                        cpuSimd,
-                                                                        enableLowpass);
-            frameEdgeDensity += result.edgeDensityPerBlock[blockIndex];
-            blockIndex++;
+            result.entropyUPerBlock.resize(totalNumberBlocksC);
+            result.entropyVPerBlock.resize(totalNumberBlocksC);
         }
     }
-
-    result.averageEdgeDensity = frameEdgeDensity / totalNumberBlocks;
-
+    if (cfg.enableEdgeDensity)
+        result.edgeDensityPerBlock.resize(totalNumberBlocks);
 }
 
-void computeEntropy(const Job &job,
-                    Result &result,
-                    const unsigned blockSize,
-                    CpuSimd cpuSimd,
-                    bool enableLowpass,
-                    bool enableChroma)
+void computeFrameAverages(Result &result, const vca_param &cfg)
 {
-    const auto frame = job.frame;
-    if (frame == nullptr)
-        throw std::invalid_argument("Invalid frame pointer");
-
-    const auto bitDepth      = frame->info.bitDepth;
-    const auto bytesPerPixel = (bitDepth > 8) ? 2 : 1;
-
-    auto src       = frame->planes[0];
-    auto srcStride = frame->stride[0];
-
-    auto [widthInBlocks, heightInBlock] = getFrameSizeInBlocks(blockSize, frame->info);
-    auto totalNumberBlocks              = widthInBlocks * heightInBlock;
-    auto widthInPixels                  = widthInBlocks * blockSize;
-    auto heightInPixels                 = heightInBlock * blockSize;
-
-    if (result.entropyPerBlock.size() < totalNumberBlocks)
-        result.entropyPerBlock.resize(totalNumberBlocks);
-
-    // First, we will copy the source to a temporary buffer which has one int16_t value
-    // per sample.
-    //   - This may only be needed for 8 bit values. For 16 bit values we could also
-    //     perform this directly from the source buffer. However, we should check the
-    //     performance of that approach (i.e. the buffer may not be aligned)
+    if (cfg.enableDCTenergy)
+    {
+        const auto totalNumberBlocks = result.energyPerBlock.size();
 
-    ALIGN_VAR_32(int16_t, pixelBuffer[32 * 32]);
+        uint32_t frameBrightness = 0;
+        uint32_t frameTexture    = 0;
+        for (size_t i = 0; i < totalNumberBlocks; i++)
+        {
+            frameBrightness += result.brightnessPerBlock[i];
+            frameTexture += result.energyPerBlock[i];
+        }
+        result.averageBrightness = uint32_t((double) (frameBrightness) / totalNumberBlocks);
+        result.averageEnergy     = uint32_t((double) (frameTexture)
+                                        / (totalNumberBlocks * E_norm_factor));
 
-    auto blockIndex          = 0u;
-    double frameEntropy    = 0;
-    for (unsigned blockY = 0; blockY < heightInPixels; blockY += blockSize)
-    {
-        auto paddingBottom = std::max(int(blockY + blockSize) - int(frame->info.height), 0);
-        for (unsigned blockX = 0; blockX < widthInPixels; blockX += blockSize)
+        if (cfg.enableEnergyChroma)
         {
-            auto paddingRight = std::max(int(blockX + blockSize) - int(frame->info.width), 0);
-            auto blockOffsetLumaBytes = blockX * bytesPerPixel + (blockY * srcStride);
-
-            copyPixelValuesToBuffer(bitDepth,
-                                    blockOffsetLumaBytes,
-                                    blockSize,
-                                    src,
-                                    srcStride,
-                                    pixelBuffer,
-                                    unsigned(paddingRight),
-                                    unsigned(paddingBottom));
-
-            result.entropyPerBlock[blockIndex] = performEntropy(blockSize,
-                                                                bitDepth,
-                                                                pixelBuffer,
-                                                                cpuSimd,
-                                                                enableLowpass);
-            frameEntropy += result.entropyPerBlock[blockIndex];
-            blockIndex++;
+            const auto totalNumberBlocksC = result.energyUPerBlock.size();
+
+            uint32_t frameU       = 0;
+            uint32_t frameV       = 0;
+            uint32_t frameEnergyU = 0;
+            uint32_t frameEnergyV = 0;
+            for (size_t i = 0; i < totalNumberBlocksC; i++)
+            {
+                frameU += result.averageUPerBlock[i];
+                frameEnergyU += result.energyUPerBlock[i];
+                frameV += result.averageVPerBlock[i];
+                frameEnergyV += result.energyVPerBlock[i];
+            }
+            result.averageU = uint32_t((double) (frameU) / totalNumberBlocksC);
+            result.energyU  = uint32_t((double) (frameEnergyU)
+                                      / (totalNumberBlocksC * E_norm_factor));
+            result.averageV = uint32_t((double) (frameV) / totalNumberBlocksC);
+            result.energyV  = uint32_t((double) (frameEnergyV)
+                                      / (totalNumberBlocksC * E_norm_factor));
         }
     }
 
-    result.entropyY = frameEntropy / totalNumberBlocks;
-
-    if (enableChroma)
+    if (cfg.enableEntropy)
     {
-        const auto srcU       = frame->planes[1];
-        const auto srcV       = frame->planes[2];
-        const auto srcUStride = frame->stride[1];
-        const auto srcUHeight = frame->height[1];
-        const auto srcUWidth  = srcUStride / bytesPerPixel;
-
-        auto [widthInBlocksC, heightInBlockC] = getChromaFrameSizeInBlocks(blockSize,
-                                                                           srcUWidth,
-                                                                           srcUHeight);
-        const auto totalNumberBlocksC         = widthInBlocksC * heightInBlockC;
-        const auto widthInPixelsC             = widthInBlocksC * blockSize;
-        const auto heightInPixelsC            = heightInBlockC * blockSize;
-
-        if (result.entropyUPerBlock.size() < totalNumberBlocksC)
-            result.entropyUPerBlock.resize(totalNumberBlocksC);
-        if (result.entropyVPerBlock.size() < totalNumberBlocksC)
-            result.entropyVPerBlock.resize(totalNumberBlocksC);
+        const auto totalNumberBlocks = result.entropyPerBlock.size();
 
-        ALIGN_VAR_32(int16_t, pixelBufferC[32 * 32]);
+        double frameEntropy = 0;
+        for (size_t i = 0; i < totalNumberBlocks; i++)
+            frameEntropy += result.entropyPerBlock[i];
+        result.entropyY = frameEntropy / totalNumberBlocks;
 
-        auto blockIndexC      = 0u;
-        uint32_t frameU       = 0;
-        uint32_t frameV       = 0;
-        double frameEntropyU  = 0;
-        double frameEntropyV  = 0;
-        for (unsigned blockY = 0; blockY < heightInPixelsC; blockY += blockSize)
+        if (cfg.enableEntropyChroma)
         {
-            auto paddingBottom = std::max(int(blockY + blockSize) - int(srcUHeight), 0);
-            for (unsigned blockX = 0; blockX < widthInPixelsC; blockX += blockSize)
-            {
-                auto paddingRight = std::max(int(blockX + blockSize) - int(srcUStride), 0);
-                auto blockOffsetChromaBytes = blockX * bytesPerPixel + (blockY * srcUStride);
-
-                copyPixelValuesToBuffer(bitDepth,
-                                        blockOffsetChromaBytes,
-                                        blockSize,
-                                        srcU,
-                                        srcUStride,
-                                        pixelBufferC,
-                                        unsigned(paddingRight),
-                                        unsigned(paddingBottom));
-                result.entropyUPerBlock[blockIndexC] = performEntropy(blockSize,
-                                                                      bitDepth,
-                                                                      pixelBufferC,
-                                                                      cpuSimd,
-                                                                      enableLowpass);
-
-                frameEntropyU += result.entropyUPerBlock[blockIndexC];
-
-                blockIndexC++;
-            }
-        }
-        result.entropyU  = frameEntropyU / totalNumberBlocksC;
+            const auto totalNumberBlocksC = result.entropyUPerBlock.size();
 
-        blockIndexC = 0u;
-        for (unsigned blockY = 0; blockY < heightInPixelsC; blockY += blockSize)
-        {
-            auto paddingBottom = std::max(int(blockY + blockSize) - int(srcUHeight), 0);
-            for (unsigned blockX = 0; blockX < widthInPixelsC; blockX += blockSize)
+            double frameEntropyU = 0;
+            double frameEntropyV = 0;
+            for (size_t i = 0; i < totalNumberBlocksC; i++)
             {
-                auto paddingRight = std::max(int(blockX + blockSize) - int(srcUStride), 0);
-                auto blockOffsetChromaBytes = blockX * bytesPerPixel + (blockY * srcUStride);
-
-                copyPixelValuesToBuffer(bitDepth,
-                                        blockOffsetChromaBytes,
-                                        blockSize,
-                                        srcV,
-                                        srcUStride,
-                                        pixelBufferC,
-                                        unsigned(paddingRight),
-                                        unsigned(paddingBottom));
-
-                result.entropyVPerBlock[blockIndexC] = performEntropy(blockSize,
-                                                                      bitDepth,
-                                                                      pixelBufferC,
-                                                                      cpuSimd,
-                                                                      enableLowpass);
-
-                frameEntropyV += result.entropyVPerBlock[blockIndexC];
-
-                blockIndexC++;
+                frameEntropyU += result.entropyUPerBlock[i];
+                frameEntropyV += result.entropyVPerBlock[i];
             }
+            result.entropyU = frameEntropyU / totalNumberBlocksC;
+            result.entropyV = frameEntropyV / totalNumberBlocksC;
         }
-        result.entropyV = frameEntropyV / totalNumberBlocksC;
     }
 
+    if (cfg.enableEdgeDensity)
+    {
+        const auto totalNumberBlocks = result.edgeDensityPerBlock.size();
+
+        double frameEdgeDensity = 0;
+        for (size_t i = 0; i < totalNumberBlocks; i++)
+            frameEdgeDensity += result.edgeDensityPerBlock[i];
+        result.averageEdgeDensity = frameEdgeDensity / totalNumberBlocks;
+    }
 }
 
 void computeTextureSAD(Result &result, const Result &resultsPreviousFrame)
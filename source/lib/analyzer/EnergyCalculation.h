@@ -20,29 +20,49 @@
 
 #pragma once
 
+#include <analyzer/Primitives.h>
 #include <analyzer/common/common.h>
 
 namespace vca {
 
-void computeWeightedDCTEnergy(const Job &job,
-                              Result &result,
-                              const unsigned blockSize,
-                              CpuSimd cpuSimd,
-                              bool enableChroma,
-                              bool enableLowpass);
+// Calculate all enabled features for the block rows of the job in one pass over the frame. The
+// bit depth of the frame must be BitDepth. Call it through Primitives::computeFeatures.
+template<unsigned BlockSize, unsigned BitDepth>
+void computeFeatures(const Job &job,
+                     Result &result,
+                     const vca_param &cfg,
+                     const Primitives &primitives);
 void computeTextureSAD(Result &results, const Result &resultsPreviousFrame);
 void computeTextureEpsilon(Result &results, const Result &resultsPreviousFrame);
-void computeEntropy(const Job &job,
-                    Result &result,
-                    const unsigned blockSize,
-                    CpuSimd cpuSimd,
-                    bool enableLowpass,
-                    bool enableChroma);
 void computeEntropySAD(Result &results, const Result &resultsPreviousFrame);
-void computeEdgeDensity(const Job &job,
-                        Result &result,
-                        const unsigned blockSize,
-                        CpuSimd cpuSimd,
-                        bool enableLowpass);
+
+// Size the per block result vectors for the given frame and reset the values of a reused
+// result. This must be done before the slices of a frame are analyzed in parallel.
+void prepareResult(Result &result, const vca_param &cfg, const vca_frame *frame);
+// Calculate the frame averages from the per block values once all slices are done.
+void computeFrameAverages(Result &result, const vca_param &cfg);
+
+// C version of the weighted sum of the absolute DCT coefficients (see simd/energy.h)
+uint32_t weighted_coeff_sum_c(const int16_t *coeff,
+                              const int16_t *weights,
+                              unsigned stride,
+                              unsigned size);
+
+// C versions of copying a block into the int16 pixel buffer (see simd/copy.h). These are compiled
+// for each block size. blockSize must be equal to BlockSize.
+template<unsigned BlockSize>
+void copy_block_c(const int16_t *src,
+                  intptr_t srcStride,
+                  unsigned blockSize,
+                  unsigned paddingRight,
+                  unsigned paddingBottom,
+                  int16_t *dst);
+template<unsigned BlockSize>
+void copy_block_8bit_c(const uint8_t *src,
+                       intptr_t srcStride,
+                       unsigned blockSize,
+                       unsigned paddingRight,
+                       unsigned paddingBottom,
+                       int16_t *dst);
 
 } // namespace vca
@@ -19,11 +19,7 @@
  * along with this program.
  *****************************************************************************/
 #include <analyzer/EntropyCalculation.h>
-#include <analyzer/EntropyNative.h>
 #include <analyzer/common/common.h>
-#include <analyzer/simd/entropy.h>
-
-#include <cstring>
 
 namespace vca {
 
@@ -33,30 +29,14 @@ double performEntropy(const unsigned blockSize,
                       CpuSimd cpuSimd,
                       bool enableLowpass)
 {
-    std::vector<int16_t> block(blockSize * blockSize);
-
-    // Copy pixels from pixelBuffer to block
-    for (uint32_t i = 0; i < blockSize; ++i)
-    {
-        for (uint32_t j = 0; j < blockSize; ++j)
-        {
-            block[i * blockSize + j] = pixelBuffer[i * blockSize + j];
-        }
-    }
+    const auto primitives = setupPrimitives(blockSize, bitDepth, cpuSimd);
+    if (!enableLowpass)
+        return primitives.entropy(pixelBuffer, blockSize);
 
-    double entropy    = 0;
-    // Calculate entropy
-    //if (cpuSimd == CpuSimd::AVX2)
-    //{
-    //    entropy = entropy_avx2(block);
-    //}
-    //else
-    if (enableLowpass)
-        entropy = vca::entropy_lowpass_c(block, blockSize);
-    else
-        entropy = vca::entropy_c(block);
-
-    return entropy;
+    // The entropy of the block downscaled by averaging 2x2 samples
+    ALIGN_VAR_32(int16_t, downscaledBlock[16 * 16]);
+    primitives.downscale(pixelBuffer, blockSize, blockSize, downscaledBlock);
+    return primitives.entropy(downscaledBlock, blockSize / 2);
 }
 
 double performEdgeDensity(const unsigned blockSize,
@@ -65,31 +45,19 @@ double performEdgeDensity(const unsigned blockSize,
                           CpuSimd cpuSimd,
                           bool enableLowpass)
 {
-    // Calculate the total number of pixels in the block
-    unsigned blockSizeSq = blockSize * blockSize;
+    const auto primitives = setupPrimitives(blockSize, bitDepth, cpuSimd);
+    return performEdgeDensity(primitives, blockSize, bitDepth, pixelBuffer);
+}
 
+double performEdgeDensity(const Primitives &primitives,
+                          const unsigned blockSize,
+                          const unsigned bitDepth,
+                          const int16_t *pixelBuffer)
+{
     // Threshold for edge detection based on bit depth
-    int threshold = (1 << (bitDepth - 1)) - 1;
-
-    // Initialize edge count to 0
-    unsigned edgeCount = 0;
+    const auto threshold = int16_t((1 << (bitDepth - 1)) - 1);
 
-    // Iterate through the pixel buffer
-    for (unsigned i = 0; i < blockSizeSq; ++i)
-    {
-        // Check edge conditions for pixels in the buffer
-        if (i % blockSize < blockSize - 1 && abs(pixelBuffer[i] - pixelBuffer[i + 1]) > threshold)
-        {
-            // Horizontal edge detected
-            edgeCount++;
-        }
-        if (i / blockSize < blockSize - 1
-            && abs(pixelBuffer[i] - pixelBuffer[i + blockSize]) > threshold)
-        {
-            // Vertical edge detected
-            edgeCount++;
-        }
-    }
+    const auto edgeCount = primitives.edgeCount(pixelBuffer, blockSize, threshold);
 
     // Calculate edge density
     double density = static_cast<double>(edgeCount) / (2 * blockSize * (blockSize - 1));
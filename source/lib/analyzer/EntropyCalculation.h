@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <analyzer/Primitives.h>
 #include <vcaLib.h>
 
 namespace vca {
@@ -37,4 +38,10 @@ double performEdgeDensity(const unsigned blockSize,
                           CpuSimd cpuSimd,
                           bool enableLowpass);
 
+// The edge density using the kernels of the table
+double performEdgeDensity(const Primitives &primitives,
+                          const unsigned blockSize,
+                          const unsigned bitDepth,
+                          const int16_t *pixelBuffer);
+
 } // namespace vca
@@ -21,88 +21,95 @@
 
 #include "EntropyNative.h"
 
-namespace vca {
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
 
-double entropy_c(const std::vector<int16_t> &block)
+// The block may hold at most 32x32 samples.
+template<unsigned BitDepth>
+double calculateEntropy(const int16_t *samples, const unsigned nrSamples)
 {
-    std::unordered_map<int, int> pixelCounts;
-    int totalPixels = static_cast<int>(block.size());
+    constexpr int maxSampleValue = (1 << BitDepth) - 1;
 
-    // Count occurrences of each pixel value
-    for (int pixel : block)
+    int minValue = samples[0];
+    int maxValue = samples[0];
+    for (unsigned i = 1; i < nrSamples; i++)
     {
-        pixelCounts[pixel]++;
+        minValue = std::min(minValue, int(samples[i]));
+        maxValue = std::max(maxValue, int(samples[i]));
     }
 
-    // Calculate probability of each pixel value
-    std::vector<double> probabilities;
-    for (const auto &pair : pixelCounts)
+    // Samples outside of the range of the bit depth are clamped so that they fit the histogram
+    int16_t clampedSamples[32 * 32];
+    if (minValue < 0 || maxValue > maxSampleValue)
     {
-        double probability = static_cast<double>(pair.second) / totalPixels;
-        probabilities.push_back(probability);
+        for (unsigned i = 0; i < nrSamples; i++)
+            clampedSamples[i] = int16_t(std::clamp(int(samples[i]), 0, maxSampleValue));
+        samples  = clampedSamples;
+        minValue = std::clamp(minValue, 0, maxSampleValue);
+        maxValue = std::clamp(maxValue, 0, maxSampleValue);
     }
 
-    // Calculate entropy
+    // Only the bins in the range [minValue, maxValue] are used
+    uint16_t histogram[maxSampleValue + 1];
+    std::memset(&histogram[minValue], 0, (maxValue - minValue + 1) * sizeof(uint16_t));
+
+    for (unsigned i = 0; i < nrSamples; i++)
+        histogram[samples[i]]++;
+
     double entropy = 0.0;
-    for (double probability : probabilities)
+    for (int value = minValue; value <= maxValue; value++)
     {
-        entropy -= probability * log2(probability);
+        if (histogram[value] > 0)
+        {
+            const auto probability = static_cast<double>(histogram[value]) / nrSamples;
+            entropy -= probability * std::log2(probability);
+        }
     }
 
     return entropy;
 }
 
-double entropy_lowpass_c(const std::vector<int16_t> &block, int width)
+double calculateEntropy(const int16_t *samples, const unsigned nrSamples, const unsigned bitDepth)
 {
-    // Check if width and height are divisible by 2
-    if (width % 2 != 0)
-    {
-        return -1.0; // Error: Width is not divisible by 2
-    }
-
-    std::unordered_map<int, int> pixelCounts;
-
-    // Downscale the block by averaging 2x2 blocks of pixels into a single pixel
-    int downscaledWidth  = width >> 1;
-    std::vector<int> downscaledBlock(downscaledWidth * downscaledWidth, 0);
-
-    for (int i = 0; i < width; i += 2)
-    {
-        for (int j = 0; j < width; j += 2)
-        {
-            // Compute average pixel value of 2x2 block
-            int sum = block[i * width + j] + block[i * width + j + 1] + block[(i + 1) * width + j]
-                      + block[(i + 1) * width + j + 1];
-            int averagePixel = sum >> 2;
+    if (bitDepth == 8)
+        return calculateEntropy<8>(samples, nrSamples);
+    if (bitDepth == 10)
+        return calculateEntropy<10>(samples, nrSamples);
+    return calculateEntropy<12>(samples, nrSamples);
+}
 
-            // Store the average pixel value in the downscaled block
-            downscaledBlock[(i / 2) * downscaledWidth + (j / 2)] = averagePixel;
+} // namespace
 
-            // Count occurrences of the average pixel value
-            pixelCounts[averagePixel]++;
-        }
-    }
+namespace vca {
 
-    // Calculate probability of each pixel value in the downscaled block
-    int totalPixels = downscaledWidth * downscaledWidth;
-    std::vector<double> probabilities;
-    for (const auto &pair : pixelCounts)
-    {
-        double probability = static_cast<double>(pair.second) / totalPixels;
-        probabilities.push_back(probability);
-    }
+double entropy_c(const int16_t *block, unsigned blockSize, unsigned bitDepth)
+{
+    return calculateEntropy(block, blockSize * blockSize, bitDepth);
+}
 
-    // Calculate entropy of the downscaled block
-    double entropy = 0.0;
-    for (double probability : probabilities)
+// The comparisons are summed up without branches
+template<unsigned BlockSize>
+uint32_t edge_count_c(const int16_t *pixelBuffer, unsigned /* blockSize */, int16_t threshold)
+{
+    uint32_t edgeCount = 0;
+    for (unsigned y = 0; y < BlockSize; y++)
     {
-        if (probability > 0.0)
-        {
-            entropy -= probability * log2(probability);
-        }
+        const auto row = pixelBuffer + y * BlockSize;
+        for (unsigned x = 0; x + 1 < BlockSize; x++)
+            edgeCount += unsigned(std::abs(row[x] - row[x + 1]) > threshold);
+        if (y + 1 < BlockSize)
+            for (unsigned x = 0; x < BlockSize; x++)
+                edgeCount += unsigned(std::abs(row[x] - row[x + BlockSize]) > threshold);
     }
-
-    return entropy;
+    return edgeCount;
 }
 
-}
+template uint32_t edge_count_c<8>(const int16_t *, unsigned, int16_t);
+template uint32_t edge_count_c<16>(const int16_t *, unsigned, int16_t);
+template uint32_t edge_count_c<32>(const int16_t *, unsigned, int16_t);
+
+} // namespace vca
@@ -22,14 +22,16 @@
 #pragma once
 
 #include <cstdint>
-#include <cmath>
-#include <vector>
-#include <unordered_map>
 
 namespace vca {
 
-double entropy_c(const std::vector<int16_t> &block);
-double entropy_lowpass_c(const std::vector<int16_t> &block, int blocksize);
+// Entropy of the samples of a block. The histogram lives on the stack so no memory is
+// allocated per block.
+double entropy_c(const int16_t *block, unsigned blockSize, unsigned bitDepth);
 
-} // namespace vca
+// Count the pairs of horizontally and vertically neighboring samples whose absolute difference is
+// above the threshold. This is compiled for each block size. blockSize must be equal to BlockSize.
+template<unsigned BlockSize>
+uint32_t edge_count_c(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold);
 
+} // namespace vca
@@ -0,0 +1,125 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "Executor.h"
+
+#include <analyzer/Analyzer.h>
+
+#include <algorithm>
+
+namespace vca {
+
+Executor::Executor(unsigned nrThreads)
+{
+    if (nrThreads == 0)
+        nrThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (unsigned i = 0; i < nrThreads; i++)
+        this->threads.emplace_back(&Executor::threadFunction, this, i);
+}
+
+Executor::~Executor()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->access);
+        this->aborted = true;
+    }
+    this->workAvailableCV.notify_all();
+    for (auto &thread : this->threads)
+        thread.join();
+}
+
+unsigned Executor::getNumberOfThreads() const
+{
+    return unsigned(this->threads.size());
+}
+
+void Executor::attach(Analyzer *analyzer)
+{
+    auto attached      = std::make_unique<AttachedAnalyzer>();
+    attached->analyzer = analyzer;
+
+    std::unique_lock<std::mutex> lock(this->access);
+    this->analyzers.push_back(std::move(attached));
+}
+
+void Executor::detach(Analyzer *analyzer)
+{
+    std::unique_lock<std::mutex> lock(this->access);
+    auto attached = std::find_if(this->analyzers.begin(),
+                                 this->analyzers.end(),
+                                 [analyzer](const std::unique_ptr<AttachedAnalyzer> &a) {
+                                     return a->analyzer == analyzer;
+                                 });
+    if (attached == this->analyzers.end())
+        return;
+
+    // No new jobs are started. The running ones must finish before the analyzer is gone.
+    auto &entry    = **attached;
+    entry.detached = true;
+    this->jobFinishedCV.wait(lock, [&entry]() { return entry.nrRunningJobs == 0; });
+
+    this->analyzers.erase(std::find_if(this->analyzers.begin(),
+                                       this->analyzers.end(),
+                                       [&entry](const std::unique_ptr<AttachedAnalyzer> &a) {
+                                           return a.get() == &entry;
+                                       }));
+}
+
+void Executor::notifyWorkAvailable()
+{
+    {
+        std::unique_lock<std::mutex> lock(this->access);
+        this->workCounter++;
+    }
+    this->workAvailableCV.notify_all();
+}
+
+void Executor::threadFunction(unsigned id)
+{
+    std::unique_lock<std::mutex> lock(this->access);
+    while (!this->aborted)
+    {
+        const auto workCounterBefore = this->workCounter;
+
+        // Run one job of the next analyzer in turn. Analyzers without work are skipped.
+        bool ranJob      = false;
+        const auto first = this->nextAnalyzer++;
+        for (size_t i = 0; i < this->analyzers.size() && !ranJob && !this->aborted; i++)
+        {
+            auto &attached = *this->analyzers[(first + i) % this->analyzers.size()];
+            if (attached.detached)
+                continue;
+
+            attached.nrRunningJobs++;
+            lock.unlock();
+            ranJob = attached.analyzer->runNextJob(id);
+            lock.lock();
+            attached.nrRunningJobs--;
+            if (attached.detached && attached.nrRunningJobs == 0)
+                this->jobFinishedCV.notify_all();
+        }
+
+        if (!ranJob)
+            this->workAvailableCV.wait(lock, [this, workCounterBefore]() {
+                return this->workCounter != workCounterBefore || this->aborted;
+            });
+    }
+}
+
+} // namespace vca
@@ -0,0 +1,77 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vca {
+
+class Analyzer;
+
+// A pool of worker threads that is shared by several analyzers. This bounds the number of
+// threads when many streams are analyzed at the same time. The threads take turns between the
+// attached analyzers so that every analyzer with pending work gets the same share of the threads.
+class Executor
+{
+public:
+    Executor() = delete;
+    // 0 threads means one per CPU core
+    Executor(unsigned nrThreads);
+    ~Executor();
+
+    unsigned getNumberOfThreads() const;
+
+    // An attached analyzer must be detached before it is destroyed. Detaching waits until no
+    // thread works on a job of the analyzer anymore.
+    void attach(Analyzer *analyzer);
+    void detach(Analyzer *analyzer);
+
+    // Wake up the threads after an analyzer queued a new frame
+    void notifyWorkAvailable();
+
+private:
+    struct AttachedAnalyzer
+    {
+        Analyzer *analyzer{};
+        unsigned nrRunningJobs{};
+        bool detached{};
+    };
+
+    void threadFunction(unsigned id);
+
+    std::mutex access;
+    std::condition_variable workAvailableCV;
+    std::condition_variable jobFinishedCV;
+    std::vector<std::unique_ptr<AttachedAnalyzer>> analyzers;
+    // The analyzer that the next thread looking for work starts with
+    size_t nextAnalyzer{};
+    // Incremented for each new frame so that a thread does not miss work that was queued while
+    // it was looking through the analyzers
+    uint64_t workCounter{};
+    bool aborted{};
+
+    std::vector<std::thread> threads;
+};
+
+} // namespace vca
@@ -0,0 +1,133 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "JobScheduler.h"
+
+#include <algorithm>
+
+namespace vca {
+
+void JobScheduler::setNumberOfWorkers(unsigned nrWorkers)
+{
+    this->workerQueues.clear();
+    for (unsigned i = 0; i < std::max(nrWorkers, 1u); i++)
+        this->workerQueues.push_back(std::make_unique<WorkerQueue>());
+}
+
+void JobScheduler::setMaximumQueueSize(size_t max)
+{
+    this->maximumQueueSize = max;
+}
+
+void JobScheduler::abort()
+{
+    this->aborted = true;
+    std::unique_lock<std::mutex> lock(this->waitMutex);
+    this->workAvailableCV.notify_all();
+    this->spaceAvailableCV.notify_all();
+}
+
+void JobScheduler::waitAndPush(Job job, unsigned blockRowsPerJob)
+{
+    {
+        std::unique_lock<std::mutex> lock(this->waitMutex);
+        this->spaceAvailableCV.wait(lock, [this]() {
+            return this->maximumQueueSize == 0 || this->nrQueuedFrames < this->maximumQueueSize
+                   || this->aborted;
+        });
+        if (this->aborted)
+            return;
+
+        // Counted before a worker can see the frame. Otherwise a worker could take all rows and
+        // decrement the counter before it was incremented.
+        this->nrQueuedFrames++;
+    }
+
+    // Distribute the frames over the workers round robin
+    const auto workerID = this->nextWorkerQueue++ % this->workerQueues.size();
+    auto &queue         = *this->workerQueues[workerID];
+    {
+        std::unique_lock<std::mutex> lock(queue.accessMutex);
+        queue.frames.push_back({job, std::max(blockRowsPerJob, 1u)});
+    }
+
+    std::unique_lock<std::mutex> lock(this->waitMutex);
+    this->workAvailableCV.notify_all();
+}
+
+bool JobScheduler::full()
+{
+    return this->maximumQueueSize > 0 && this->nrQueuedFrames >= this->maximumQueueSize;
+}
+
+std::optional<Job> JobScheduler::tryPopFrom(WorkerQueue &queue)
+{
+    std::unique_lock<std::mutex> lock(queue.accessMutex);
+    if (queue.frames.empty())
+        return {};
+
+    auto &frame = queue.frames.front();
+    auto &rows  = frame.job.macroblockRange;
+
+    auto job                = frame.job;
+    job.macroblockRange.end = std::min(rows.start + frame.blockRowsPerJob, rows.end);
+    rows.start              = job.macroblockRange.end;
+    if (rows.start == rows.end)
+    {
+        queue.frames.pop_front();
+        lock.unlock();
+
+        std::unique_lock<std::mutex> waitLock(this->waitMutex);
+        this->nrQueuedFrames--;
+        this->spaceAvailableCV.notify_one();
+    }
+    return job;
+}
+
+std::optional<Job> JobScheduler::tryPop(unsigned workerID)
+{
+    if (this->aborted)
+        return {};
+
+    // Start with the own queue and then try to steal from the others
+    const auto nrQueues = this->workerQueues.size();
+    for (size_t i = 0; i < nrQueues; i++)
+    {
+        auto &queue = *this->workerQueues[(workerID + i) % nrQueues];
+        if (auto job = this->tryPopFrom(queue))
+            return job;
+    }
+    return {};
+}
+
+std::optional<Job> JobScheduler::waitAndPop(unsigned workerID)
+{
+    while (!this->aborted)
+    {
+        if (auto job = this->tryPop(workerID))
+            return job;
+
+        std::unique_lock<std::mutex> lock(this->waitMutex);
+        this->workAvailableCV.wait(lock, [this]() {
+            return this->nrQueuedFrames > 0 || this->aborted;
+        });
+    }
+    return {};
+}
+
+} // namespace vca
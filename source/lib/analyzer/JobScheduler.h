@@ -0,0 +1,85 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <analyzer/common/common.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace vca {
+
+// Distributes the block rows of the pushed frames to the worker threads. Each worker has its own
+// deque of frames. A worker takes ranges of block rows from the oldest frame in its own deque.
+// If its deque is empty, it steals ranges from the frames in the deques of the other workers.
+// So all workers keep busy even if there are fewer frames in flight than workers.
+class JobScheduler
+{
+public:
+    // Both must be set before the scheduler is used
+    void setNumberOfWorkers(unsigned nrWorkers);
+    // If this many frames still have rows that were not taken by a worker, pushing waits
+    void setMaximumQueueSize(size_t max);
+
+    // Queue the block rows of the job. Workers take up to blockRowsPerJob rows at a time.
+    void waitAndPush(Job job, unsigned blockRowsPerJob);
+    bool full();
+
+    // Get the next range of block rows for the worker. Wait if there is no work.
+    // Will return empty opt if abort is called.
+    std::optional<Job> waitAndPop(unsigned workerID);
+    // Like waitAndPop but returns an empty opt right away if there is no work
+    std::optional<Job> tryPop(unsigned workerID);
+
+    void abort();
+
+private:
+    struct QueuedFrame
+    {
+        // The range of the job are the rows that were not taken yet
+        Job job;
+        unsigned blockRowsPerJob{};
+    };
+
+    struct alignas(64) WorkerQueue
+    {
+        std::mutex accessMutex;
+        std::deque<QueuedFrame> frames;
+    };
+
+    std::optional<Job> tryPopFrom(WorkerQueue &queue);
+
+    std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
+    std::atomic<unsigned> nextWorkerQueue{};
+
+    std::mutex waitMutex;
+    std::condition_variable workAvailableCV;
+    std::condition_variable spaceAvailableCV;
+    std::atomic<size_t> nrQueuedFrames{};
+    size_t maximumQueueSize{};
+
+    std::atomic<bool> aborted{};
+};
+
+} // namespace vca
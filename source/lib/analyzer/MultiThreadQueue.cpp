@@ -20,70 +20,219 @@
 
 #include <analyzer/common/common.h>
 
+#include <algorithm>
+#include <thread>
+
 namespace vca {
 
+namespace {
+
+// Number of attempts to push/pop before the thread goes to sleep. Spinning only makes sense if
+// the other side can run at the same time.
+const unsigned NR_SPINS = std::thread::hardware_concurrency() > 1 ? 64 : 0;
+
+constexpr size_t DEFAULT_CAPACITY = 16;
+
+} // namespace
+
+template<class T>
+MultiThreadQueue<T>::MultiThreadQueue()
+{
+    this->setMaximumQueueSize(DEFAULT_CAPACITY);
+}
+
 template<class T>
 void MultiThreadQueue<T>::abort()
 {
     this->aborted = true;
-    this->pushJobCV.notify_all();
-    this->popJobCV.notify_all();
+    std::unique_lock<std::mutex> lock(this->waitMutex);
+    this->notFullCV.notify_all();
+    this->notEmptyCV.notify_all();
 }
 
 template<class T>
-void MultiThreadQueue<T>::waitAndPush(T item)
+bool MultiThreadQueue<T>::tryPush(T &item)
 {
-    if (this->aborted)
+    auto position = this->pushPosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto &slot     = this->slots[position % this->capacity];
+        const auto seq = slot.sequence.load(std::memory_order_acquire);
+        const auto dif = intptr_t(seq) - intptr_t(position);
+        if (dif == 0)
+        {
+            if (this->pushPosition.compare_exchange_weak(position,
+                                                         position + 1,
+                                                         std::memory_order_relaxed))
+            {
+                slot.item = std::move(item);
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (dif < 0)
+            return false;
+        else
+            position = this->pushPosition.load(std::memory_order_relaxed);
+    }
+}
+
+template<class T>
+bool MultiThreadQueue<T>::tryPop(T &item)
+{
+    auto position = this->popPosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto &slot     = this->slots[position % this->capacity];
+        const auto seq = slot.sequence.load(std::memory_order_acquire);
+        const auto dif = intptr_t(seq) - intptr_t(position + 1);
+        if (dif == 0)
+        {
+            if (this->popPosition.compare_exchange_weak(position,
+                                                        position + 1,
+                                                        std::memory_order_relaxed))
+            {
+                item = std::move(slot.item);
+                slot.sequence.store(position + this->capacity, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (dif < 0)
+            return false;
+        else
+            position = this->popPosition.load(std::memory_order_relaxed);
+    }
+}
+
+template<class T>
+bool MultiThreadQueue<T>::tryPushToSlot(T &item, size_t position)
+{
+    auto &slot = this->slots[position % this->capacity];
+    if (slot.sequence.load(std::memory_order_acquire) != position)
+        return false;
+
+    slot.item = std::move(item);
+    slot.sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+void MultiThreadQueue<T>::pushToOverflow(T &item, size_t position)
+{
+    std::unique_lock<std::mutex> lock(this->overflowMutex);
+    // Pairs with the fence in moveFromOverflow. Either the slot is seen as free here or the
+    // popping thread sees the overflow item.
+    this->nrOverflowItems++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->tryPushToSlot(item, position))
+    {
+        this->nrOverflowItems--;
+        return;
+    }
+    this->overflow.emplace(position, std::move(item));
+}
+
+template<class T>
+void MultiThreadQueue<T>::moveFromOverflow()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->nrOverflowItems.load(std::memory_order_relaxed) == 0)
         return;
 
-    std::unique_lock<std::mutex> lock(this->accessMutex);
-    this->popJobCV.wait(lock, [this]() {
-        return this->maximumQueueSize == 0 || this->items.size() < this->maximumQueueSize
-               || this->aborted;
+    // The slots are freed in order. So if an item does not fit, the later ones do not either.
+    std::unique_lock<std::mutex> lock(this->overflowMutex);
+    while (!this->overflow.empty())
+    {
+        auto first = this->overflow.begin();
+        if (!this->tryPushToSlot(first->second, first->first))
+            break;
+        this->overflow.erase(first);
+        this->nrOverflowItems--;
+    }
+}
+
+template<class T>
+template<typename Operation>
+bool MultiThreadQueue<T>::waitFor(Operation tryOperation,
+                                  std::atomic<unsigned> &nrWaiting,
+                                  std::condition_variable &cv)
+{
+    for (unsigned spin = 0; spin < NR_SPINS; spin++)
+    {
+        if (tryOperation())
+            return true;
+        if (this->aborted)
+            return false;
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(this->waitMutex);
+    nrWaiting++;
+    // Pairs with the fence in notifyWaiting so that either the last try succeeds or the other
+    // side sees the waiting thread
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto done = false;
+    cv.wait(lock, [&]() {
+        done = tryOperation();
+        return done || this->aborted;
     });
+    nrWaiting--;
+    return done;
+}
 
-    if (this->aborted)
+template<class T>
+void MultiThreadQueue<T>::notifyWaiting(std::atomic<unsigned> &nrWaiting,
+                                        std::condition_variable &cv)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (nrWaiting.load(std::memory_order_relaxed) == 0)
         return;
 
-    this->items.push(std::move(item));
-    this->pushJobCV.notify_one();
+    std::unique_lock<std::mutex> lock(this->waitMutex);
+    cv.notify_all();
 }
 
 template<class T>
-void MultiThreadQueue<T>::waitAndPushInOrder(T item, size_t orderCounter)
+void MultiThreadQueue<T>::waitAndPush(T item)
 {
-    if (this->aborted)
+    if (!this->waitFor([&]() { return this->tryPush(item); }, this->nrWaitingPush, this->notFullCV))
         return;
 
-    std::unique_lock<std::mutex> lock(this->accessMutex);
-    this->popJobCV.wait(lock, [this, orderCounter]() {
-        if (this->aborted)
-            return true;
-        auto slotFree = this->maximumQueueSize == 0 || this->items.size() < this->maximumQueueSize;
-        return slotFree && orderCounter == this->pushCounter;
-    });
+    this->notifyWaiting(this->nrWaitingPop, this->notEmptyCV);
+}
 
-    if (this->aborted)
+template<class T>
+void MultiThreadQueue<T>::waitAndPushInOrder(T item, size_t orderCounter)
+{
+    // The item goes directly into the slot of its position in the order. This only waits if the
+    // slot is still occupied by the item one lap earlier, which means that the queue is full.
+    // An unbounded queue puts the item into the overflow list instead.
+    if (this->unbounded)
+    {
+        if (!this->tryPushToSlot(item, orderCounter))
+            this->pushToOverflow(item, orderCounter);
+    }
+    else if (!this->waitFor([&]() { return this->tryPushToSlot(item, orderCounter); },
+                            this->nrWaitingPush,
+                            this->notFullCV))
         return;
 
-    this->items.push(std::move(item));
-    this->pushCounter++;
-    this->popJobCV.notify_all();
-    this->pushJobCV.notify_one();
+    this->notifyWaiting(this->nrWaitingPop, this->notEmptyCV);
 }
 
 template<class T>
 std::optional<T> MultiThreadQueue<T>::waitAndPop()
 {
-    std::unique_lock<std::mutex> lock(this->accessMutex);
-    this->pushJobCV.wait(lock, [this]() { return !this->items.empty() || this->aborted; });
-
-    if (this->aborted)
+    T item;
+    if (!this->waitFor([&]() { return this->tryPop(item); }, this->nrWaitingPop, this->notEmptyCV))
         return {};
 
-    auto item = this->items.front();
-    this->items.pop();
-    this->popJobCV.notify_one();
+    if (this->unbounded)
+    {
+        this->moveFromOverflow();
+        this->notifyWaiting(this->nrWaitingPop, this->notEmptyCV);
+    }
+    this->notifyWaiting(this->nrWaitingPush, this->notFullCV);
     return item;
 }
 
@@ -93,17 +242,30 @@ bool MultiThreadQueue<T>::empty()
     if (this->aborted)
         return false;
 
-    std::unique_lock<std::mutex> lock(this->accessMutex);
-    return this->items.empty();
+    const auto position = this->popPosition.load(std::memory_order_acquire);
+    const auto &slot    = this->slots[position % this->capacity];
+    return slot.sequence.load(std::memory_order_acquire) != position + 1;
 }
 
 template<class T>
 void MultiThreadQueue<T>::setMaximumQueueSize(size_t max)
 {
-    this->maximumQueueSize = max;
+    this->capacity = std::max(max, size_t(1));
+    this->slots    = std::make_unique<Slot[]>(this->capacity);
+    for (size_t i = 0; i < this->capacity; i++)
+        this->slots[i].sequence.store(i, std::memory_order_relaxed);
+    this->pushPosition = 0;
+    this->popPosition  = 0;
+    this->unbounded    = false;
+}
+
+template<class T>
+void MultiThreadQueue<T>::setUnboundedQueueSize(size_t ringSize)
+{
+    this->setMaximumQueueSize(ringSize);
+    this->unbounded = true;
 }
 
-template class MultiThreadQueue<Job>;
-template class MultiThreadQueue<Result>;
+template class MultiThreadQueue<SharedFrameResult *>;
 
 } // namespace vca
@@ -18,22 +18,32 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
 
 namespace vca {
 
+// A bounded multi producer multi consumer queue. Items are passed through a lock free ring
+// buffer. Only if the queue is full (push) or empty (pop) for a while, the calling thread goes
+// to sleep on a condition variable until it is woken up by the other side.
+// For in order pushes the ring buffer is the reorder window. Items are parked in the slot of
+// their counter and are popped in order once all earlier items arrived. An unbounded queue keeps
+// the in order items that do not fit into the ring buffer in an overflow list.
 template<class T>
 class MultiThreadQueue
 {
 public:
+    MultiThreadQueue();
+
     // Push an item to the queue. Wait if the queue reached a maximum size.
-    // Wake one waiting thread.
     void waitAndPush(T item);
     // Push items in order. Increase the counter by one in the order of items.
-    // Pushing threads will be paused until the pushs are in order.
+    // Items may be pushed out of order. Pushing threads only wait if the item is more than
+    // the queue size ahead of the next item to pop.
     // Don't mix calls to these two push functions.
     void waitAndPushInOrder(T item, size_t counter);
 
@@ -44,19 +54,55 @@ public:
     void abort();
     bool empty();
 
-    // If the queue is fuller then this limit, the push function will wait until
-    // there is enought space. 0 means no limit.
+    // The capacity of the ring buffer. The push functions will wait until there is enough
+    // space. This must be set before the queue is used.
     void setMaximumQueueSize(size_t max);
+    // Like setMaximumQueueSize but waitAndPushInOrder never waits. Items that do not fit into
+    // the ring buffer go to the overflow list and move into the ring once there is space.
+    void setUnboundedQueueSize(size_t ringSize);
 
 private:
-    std::queue<T> items;
-    std::mutex accessMutex;
-    std::condition_variable pushJobCV;
-    std::condition_variable popJobCV;
-
-    bool aborted{};
-    size_t maximumQueueSize{};
-    size_t pushCounter{};
+    bool tryPush(T &item);
+    bool tryPushToSlot(T &item, size_t position);
+    bool tryPop(T &item);
+    void pushToOverflow(T &item, size_t position);
+    // Move the overflow items whose slots were freed into the ring buffer
+    void moveFromOverflow();
+
+    // Try the operation for a while. If it does not succeed, go to sleep until it succeeds after
+    // being woken up or until the queue is aborted.
+    template<typename Operation>
+    bool waitFor(Operation tryOperation,
+                 std::atomic<unsigned> &nrWaiting,
+                 std::condition_variable &cv);
+    // Wake up threads that went to sleep in waitFor
+    void notifyWaiting(std::atomic<unsigned> &nrWaiting, std::condition_variable &cv);
+
+    struct alignas(64) Slot
+    {
+        // The push/pop position that may use this slot next (see Vyukov's bounded queue)
+        std::atomic<size_t> sequence{};
+        T item{};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity{};
+
+    alignas(64) std::atomic<size_t> pushPosition{};
+    alignas(64) std::atomic<size_t> popPosition{};
+
+    std::mutex waitMutex;
+    std::condition_variable notFullCV;
+    std::condition_variable notEmptyCV;
+    std::atomic<unsigned> nrWaitingPush{};
+    std::atomic<unsigned> nrWaitingPop{};
+
+    bool unbounded{};
+    std::mutex overflowMutex;
+    std::map<size_t, T> overflow;
+    std::atomic<size_t> nrOverflowItems{};
+
+    std::atomic<bool> aborted{};
 };
 
 } // namespace vca
@@ -0,0 +1,402 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <analyzer/Primitives.h>
+
+#include <analyzer/DCTTransformsNative.h>
+#include <analyzer/Downscale.h>
+#include <analyzer/EnergyCalculation.h>
+#include <analyzer/EntropyNative.h>
+#include <analyzer/common/common.h>
+#include <analyzer/simd/copy.h>
+#include <analyzer/simd/dct-avx512.h>
+#include <analyzer/simd/dct-neon.h>
+#include <analyzer/simd/dct-ssse3.h>
+#include <analyzer/simd/dct8.h>
+#include <analyzer/simd/downscale.h>
+#include <analyzer/simd/edgedensity.h>
+#include <analyzer/simd/energy.h>
+#include <analyzer/simd/entropy.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace vca {
+
+namespace {
+
+// The kernels of the simd libraries which are built once per bit depth
+template<unsigned BitDepth>
+struct BitDepthKernels;
+
+#if VCA_ARCH_X86
+#define DEFINE_BIT_DEPTH_KERNELS(bitDepth)                                                         \
+    template<>                                                                                     \
+    struct BitDepthKernels<bitDepth>                                                               \
+    {                                                                                              \
+        static constexpr dct_t dct8_sse2        = vca_dct8_##bitDepth##bit_sse2;                   \
+        static constexpr dct_t dct8_sse4        = vca_dct8_##bitDepth##bit_sse4;                   \
+        static constexpr dct_t dct8_avx2        = vca_dct8_##bitDepth##bit_avx2;                   \
+        static constexpr dct_t dct16_ssse3      = vca_dct16_##bitDepth##bit_ssse3;                 \
+        static constexpr dct_t dct16_avx2       = vca_dct16_##bitDepth##bit_avx2;                  \
+        static constexpr dct_t dct32_ssse3      = vca_dct32_##bitDepth##bit_ssse3;                 \
+        static constexpr dct_t dct32_avx2       = vca_dct32_##bitDepth##bit_avx2;                  \
+        static constexpr entropy_t entropy_avx2 = vca_entropy_##bitDepth##bit_avx2;                \
+    };
+#elif VCA_ARCH_ARM64
+#define DEFINE_BIT_DEPTH_KERNELS(bitDepth)                                                         \
+    template<>                                                                                     \
+    struct BitDepthKernels<bitDepth>                                                               \
+    {                                                                                              \
+        static constexpr entropy_t entropy_neon = vca_entropy_##bitDepth##bit_neon;                \
+    };
+#else
+#define DEFINE_BIT_DEPTH_KERNELS(bitDepth)                                                         \
+    template<>                                                                                     \
+    struct BitDepthKernels<bitDepth>                                                               \
+    {                                                                                              \
+    };
+#endif
+
+DEFINE_BIT_DEPTH_KERNELS(8)
+DEFINE_BIT_DEPTH_KERNELS(10)
+DEFINE_BIT_DEPTH_KERNELS(12)
+
+#undef DEFINE_BIT_DEPTH_KERNELS
+
+// Adapters for kernels that take the bit depth as an argument
+
+template<void (*Dct)(const int16_t *, int16_t *, intptr_t, unsigned), unsigned BitDepth>
+void dctWithBitDepth(const int16_t *src, int16_t *dst, intptr_t srcStride)
+{
+    Dct(src, dst, srcStride, BitDepth);
+}
+
+template<unsigned BitDepth>
+double entropyWithBitDepth(const int16_t *src, unsigned blockSize)
+{
+    return entropy_c(src, blockSize, BitDepth);
+}
+
+// Adapters that read the int16 samples of a high bit depth plane
+
+template<dct_t Dct>
+void dctHighBitDepthPlane(const uint8_t *src, int16_t *dst, intptr_t srcStrideBytes)
+{
+    Dct(reinterpret_cast<const int16_t *>(src), dst, srcStrideBytes / 2);
+}
+
+template<downscale_t Downscale>
+int32_t downscaleHighBitDepthPlane(const uint8_t *src,
+                                   intptr_t srcStrideBytes,
+                                   unsigned blockSize,
+                                   int16_t *dst)
+{
+    return Downscale(reinterpret_cast<const int16_t *>(src), srcStrideBytes / 2, blockSize, dst);
+}
+
+template<void (*Copy)(const int16_t *, intptr_t, unsigned, unsigned, unsigned, int16_t *)>
+void copyHighBitDepthPlane(const uint8_t *src,
+                           intptr_t srcStrideBytes,
+                           unsigned blockSize,
+                           unsigned paddingRight,
+                           unsigned paddingBottom,
+                           int16_t *dst)
+{
+    Copy(reinterpret_cast<const int16_t *>(src),
+         srcStrideBytes / 2,
+         blockSize,
+         paddingRight,
+         paddingBottom,
+         dst);
+}
+
+#if VCA_ARCH_X86
+
+// The assembly kernels only read int16 samples. For these the 8 bit samples are still widened
+// into a temporary buffer.
+template<dct_t Dct, unsigned BlockSize>
+void dctWidened8BitPlane(const uint8_t *src, int16_t *dst, intptr_t srcStride)
+{
+    ALIGN_VAR_32(int16_t, pixelBuffer[BlockSize * BlockSize]);
+    for (unsigned y = 0; y < BlockSize; y++, src += srcStride)
+        for (unsigned x = 0; x < BlockSize; x++)
+            pixelBuffer[y * BlockSize + x] = int16_t(src[x]);
+    Dct(pixelBuffer, dst, BlockSize);
+}
+
+// The AVX2 8x8 transform uses aligned loads for the rows
+template<dct_t Dct>
+void dct8AlignedHighBitDepthPlane(const uint8_t *src, int16_t *dst, intptr_t srcStrideBytes)
+{
+    const auto src16    = reinterpret_cast<const int16_t *>(src);
+    const auto stride16 = srcStrideBytes / 2;
+    if (((reinterpret_cast<uintptr_t>(src) | uintptr_t(srcStrideBytes)) % 16) == 0)
+    {
+        Dct(src16, dst, stride16);
+        return;
+    }
+
+    ALIGN_VAR_32(int16_t, pixelBuffer[8 * 8]);
+    for (unsigned y = 0; y < 8; y++)
+        std::memcpy(pixelBuffer + y * 8, src16 + y * stride16, 8 * sizeof(int16_t));
+    Dct(pixelBuffer, dst, 8);
+}
+
+#endif
+
+// Register a size x size transform. It is the DCT of blocks of that size and the lowpass DCT of
+// blocks of twice that size.
+void setDCT(Primitives &p, unsigned blockSize, unsigned size, dct_t dct, dct_plane_t dctFromPlane)
+{
+    if (blockSize == size)
+    {
+        p.dct          = dct;
+        p.dctFromPlane = dctFromPlane;
+    }
+    else if (blockSize == 2 * size)
+        p.lowpassDCT = dct;
+}
+
+template<unsigned BlockSize, unsigned BitDepth>
+void setupCPrimitives(Primitives &p)
+{
+    constexpr auto is8Bit = BitDepth == 8;
+
+    constexpr auto dct32 = dctWithBitDepth<dct32_c, BitDepth>;
+    constexpr auto dct16 = dctWithBitDepth<dct16_c, BitDepth>;
+    constexpr auto dct8  = dctWithBitDepth<dct8_c, BitDepth>;
+    setDCT(p, BlockSize, 32, dct32, is8Bit ? dct_plane_t(dct32_c) : dctHighBitDepthPlane<dct32>);
+    setDCT(p, BlockSize, 16, dct16, is8Bit ? dct_plane_t(dct16_c) : dctHighBitDepthPlane<dct16>);
+    setDCT(p, BlockSize, 8, dct8, is8Bit ? dct_plane_t(dct8_c) : dctHighBitDepthPlane<dct8>);
+
+    constexpr auto downscale = downscale_c<BlockSize>;
+    constexpr auto copyBlock = copy_block_c<BlockSize>;
+
+    p.downscale          = downscale;
+    p.downscaleFromPlane = is8Bit ? downscale_8bit_c<BlockSize>
+                                  : downscaleHighBitDepthPlane<downscale>;
+    p.copyBlock          = is8Bit ? copy_block_8bit_c<BlockSize> : copyHighBitDepthPlane<copyBlock>;
+    p.weightedCoeffSum   = weighted_coeff_sum_c;
+    p.entropy            = entropyWithBitDepth<BitDepth>;
+    p.edgeCount          = edge_count_c<BlockSize>;
+    p.computeFeatures    = computeFeatures<BlockSize, BitDepth>;
+}
+
+#if VCA_ARCH_X86
+
+// Each kernel is only used at the levels that it was selected for before the table existed.
+// The assembly kernels (the 8x8 transforms and the AVX2 16x16 and 32x32 transforms) are only
+// stubs without nasm, so they are only set if nasm is enabled.
+template<unsigned BitDepth>
+void setupX86Primitives(Primitives &p, unsigned blockSize, CpuSimd cpuSimd)
+{
+    using Kernels         = BitDepthKernels<BitDepth>;
+    constexpr auto is8Bit = BitDepth == 8;
+
+    const auto useAVX2 = cpuSimd == CpuSimd::AVX2 || cpuSimd == CpuSimd::AVX512;
+    const auto useSSE2 = cpuSimd == CpuSimd::SSE2 || cpuSimd == CpuSimd::SSSE3
+                         || cpuSimd == CpuSimd::SSE4;
+    const auto useSSSE3 = cpuSimd == CpuSimd::SSSE3 || cpuSimd == CpuSimd::SSE4;
+
+    if (useAVX2)
+    {
+        p.downscale          = vca_downscale_2x2_avx2;
+        p.downscaleFromPlane = is8Bit ? vca_downscale_2x2_8bit_avx2
+                                      : downscaleHighBitDepthPlane<vca_downscale_2x2_avx2>;
+        p.copyBlock          = is8Bit ? vca_copy_block_8bit_avx2
+                                      : copyHighBitDepthPlane<vca_copy_block_avx2>;
+        p.entropy            = Kernels::entropy_avx2;
+        p.edgeCount          = vca_edge_count_avx2;
+    }
+    else if (useSSE2)
+    {
+        p.downscale          = vca_downscale_2x2_sse2;
+        p.downscaleFromPlane = is8Bit ? vca_downscale_2x2_8bit_sse2
+                                      : downscaleHighBitDepthPlane<vca_downscale_2x2_sse2>;
+        p.copyBlock          = is8Bit ? vca_copy_block_8bit_sse2
+                                      : copyHighBitDepthPlane<vca_copy_block_sse2>;
+    }
+    if (useSSSE3)
+        p.edgeCount = vca_edge_count_ssse3;
+
+    if (cpuSimd == CpuSimd::AVX512)
+        p.weightedCoeffSum = vca_weighted_coeff_sum_avx512;
+    else if (cpuSimd == CpuSimd::AVX2)
+        p.weightedCoeffSum = vca_weighted_coeff_sum_avx2;
+    else if (useSSSE3)
+        p.weightedCoeffSum = vca_weighted_coeff_sum_ssse3;
+
+    if (cpuSimd == CpuSimd::AVX512)
+    {
+        constexpr auto dct32 = dctWithBitDepth<vca_dct32_avx512, BitDepth>;
+        constexpr auto dct16 = dctWithBitDepth<vca_dct16_avx512, BitDepth>;
+        setDCT(p,
+               blockSize,
+               32,
+               dct32,
+               is8Bit ? vca_dct32_8bit_avx512 : dctHighBitDepthPlane<dct32>);
+        setDCT(p,
+               blockSize,
+               16,
+               dct16,
+               is8Bit ? vca_dct16_8bit_avx512 : dctHighBitDepthPlane<dct16>);
+    }
+#if ENABLE_NASM
+    else if (cpuSimd == CpuSimd::AVX2)
+    {
+        constexpr auto dct32 = Kernels::dct32_avx2;
+        constexpr auto dct16 = Kernels::dct16_avx2;
+        setDCT(p,
+               blockSize,
+               32,
+               dct32,
+               is8Bit ? dctWidened8BitPlane<dct32, 32> : dctHighBitDepthPlane<dct32>);
+        setDCT(p,
+               blockSize,
+               16,
+               dct16,
+               is8Bit ? dctWidened8BitPlane<dct16, 16> : dctHighBitDepthPlane<dct16>);
+    }
+    else if (cpuSimd == CpuSimd::SSSE3)
+#else
+    // The SSSE3 intrinsics are the next best without the AVX2 assembly
+    else if (cpuSimd == CpuSimd::SSSE3 || cpuSimd == CpuSimd::AVX2)
+#endif
+    {
+        constexpr auto dct32 = Kernels::dct32_ssse3;
+        constexpr auto dct16 = Kernels::dct16_ssse3;
+        setDCT(p,
+               blockSize,
+               32,
+               dct32,
+               is8Bit ? dct_plane_t(vca_dct32_8bit_ssse3) : dctHighBitDepthPlane<dct32>);
+        setDCT(p,
+               blockSize,
+               16,
+               dct16,
+               is8Bit ? dct_plane_t(vca_dct16_8bit_ssse3) : dctHighBitDepthPlane<dct16>);
+    }
+
+#if ENABLE_NASM
+    // There is no AVX-512 version of the 8x8 transform
+    if (useAVX2)
+    {
+        constexpr auto dct8 = Kernels::dct8_avx2;
+        setDCT(p,
+               blockSize,
+               8,
+               dct8,
+               is8Bit ? dctWidened8BitPlane<dct8, 8> : dct8AlignedHighBitDepthPlane<dct8>);
+    }
+    else if (cpuSimd == CpuSimd::SSE4)
+    {
+        constexpr auto dct8 = Kernels::dct8_sse4;
+        setDCT(p,
+               blockSize,
+               8,
+               dct8,
+               is8Bit ? dctWidened8BitPlane<dct8, 8> : dctHighBitDepthPlane<dct8>);
+    }
+    else if (cpuSimd == CpuSimd::SSE2)
+    {
+        constexpr auto dct8 = Kernels::dct8_sse2;
+        setDCT(p,
+               blockSize,
+               8,
+               dct8,
+               is8Bit ? dctWidened8BitPlane<dct8, 8> : dctHighBitDepthPlane<dct8>);
+    }
+#endif
+}
+
+#elif VCA_ARCH_ARM64
+
+template<unsigned BitDepth>
+void setupNEONPrimitives(Primitives &p, unsigned blockSize)
+{
+    using Kernels         = BitDepthKernels<BitDepth>;
+    constexpr auto is8Bit = BitDepth == 8;
+
+    constexpr auto dct32 = dctWithBitDepth<vca_dct32_neon, BitDepth>;
+    constexpr auto dct16 = dctWithBitDepth<vca_dct16_neon, BitDepth>;
+    constexpr auto dct8  = dctWithBitDepth<vca_dct8_neon, BitDepth>;
+    setDCT(p, blockSize, 32, dct32, is8Bit ? vca_dct32_8bit_neon : dctHighBitDepthPlane<dct32>);
+    setDCT(p, blockSize, 16, dct16, is8Bit ? vca_dct16_8bit_neon : dctHighBitDepthPlane<dct16>);
+    setDCT(p, blockSize, 8, dct8, is8Bit ? vca_dct8_8bit_neon : dctHighBitDepthPlane<dct8>);
+
+    p.weightedCoeffSum = vca_weighted_coeff_sum_neon;
+    p.entropy          = Kernels::entropy_neon;
+    p.edgeCount        = vca_edge_count_neon;
+}
+
+#endif
+
+template<unsigned BlockSize, unsigned BitDepth>
+Primitives setupPrimitives(CpuSimd cpuSimd)
+{
+    Primitives primitives;
+    setupCPrimitives<BlockSize, BitDepth>(primitives);
+
+#if VCA_ARCH_X86
+    setupX86Primitives<BitDepth>(primitives, BlockSize, cpuSimd);
+#elif VCA_ARCH_ARM64
+    if (cpuSimd == CpuSimd::NEON)
+        setupNEONPrimitives<BitDepth>(primitives, BlockSize);
+#else
+    (void) cpuSimd;
+#endif
+
+    return primitives;
+}
+
+template<unsigned BlockSize>
+Primitives setupPrimitivesForBlockSize(unsigned bitDepth, CpuSimd cpuSimd)
+{
+    switch (bitDepth)
+    {
+        case 8:
+            return setupPrimitives<BlockSize, 8>(cpuSimd);
+        case 10:
+            return setupPrimitives<BlockSize, 10>(cpuSimd);
+        case 12:
+            return setupPrimitives<BlockSize, 12>(cpuSimd);
+        default:
+            throw std::invalid_argument("Invalid bit depth " + std::to_string(bitDepth));
+    }
+}
+
+} // namespace
+
+Primitives setupPrimitives(unsigned blockSize, unsigned bitDepth, CpuSimd cpuSimd)
+{
+    switch (blockSize)
+    {
+        case 8:
+            return setupPrimitivesForBlockSize<8>(bitDepth, cpuSimd);
+        case 16:
+            return setupPrimitivesForBlockSize<16>(bitDepth, cpuSimd);
+        case 32:
+            return setupPrimitivesForBlockSize<32>(bitDepth, cpuSimd);
+        default:
+            throw std::invalid_argument("Invalid block size " + std::to_string(blockSize));
+    }
+}
+
+} // namespace vca
@@ -0,0 +1,84 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <analyzer/common/common.h>
+#include <vcaLib.h>
+
+#include <cstdint>
+
+namespace vca {
+
+// Kernels reading int16 samples take the stride in samples. The *_plane_t kernels read the
+// samples of a plane directly (8 bit samples are widened while they are read) and take the stride
+// in bytes.
+typedef void (*dct_t)(const int16_t *src, int16_t *dst, intptr_t srcStride);
+typedef void (*dct_plane_t)(const uint8_t *src, int16_t *dst, intptr_t srcStrideBytes);
+typedef int32_t (*downscale_t)(const int16_t *src,
+                               intptr_t srcStride,
+                               unsigned blockSize,
+                               int16_t *dst);
+typedef int32_t (*downscale_plane_t)(const uint8_t *src,
+                                     intptr_t srcStrideBytes,
+                                     unsigned blockSize,
+                                     int16_t *dst);
+typedef void (*copy_block_plane_t)(const uint8_t *src,
+                                   intptr_t srcStrideBytes,
+                                   unsigned blockSize,
+                                   unsigned paddingRight,
+                                   unsigned paddingBottom,
+                                   int16_t *dst);
+typedef uint32_t (*weighted_coeff_sum_t)(const int16_t *coeff,
+                                         const int16_t *weights,
+                                         unsigned stride,
+                                         unsigned size);
+typedef double (*entropy_t)(const int16_t *src, unsigned blockSize);
+typedef uint32_t (*edge_count_t)(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold);
+
+struct Primitives;
+typedef void (*compute_features_t)(const Job &job,
+                                   Result &result,
+                                   const vca_param &cfg,
+                                   const Primitives &primitives);
+
+// The kernels for one block size and bit depth at one SIMD level. The table is resolved once per
+// analyzer so that the per block code does not branch on the SIMD level, bit depth or block size.
+struct Primitives
+{
+    dct_t dct{};
+    dct_plane_t dctFromPlane{};
+    // The transform of the block downscaled by 2. Only set for 16x16 and 32x32 blocks.
+    dct_t lowpassDCT{};
+    downscale_t downscale{};
+    downscale_plane_t downscaleFromPlane{};
+    copy_block_plane_t copyBlock{};
+    weighted_coeff_sum_t weightedCoeffSum{};
+    entropy_t entropy{};
+    edge_count_t edgeCount{};
+
+    // All features of the block rows of a job. The block loop is compiled for each combination of
+    // block size and bit depth.
+    compute_features_t computeFeatures{};
+};
+
+// Throws std::invalid_argument for an unsupported block size or bit depth. cpuSimd must be
+// supported by the CPU.
+Primitives setupPrimitives(unsigned blockSize, unsigned bitDepth, CpuSimd cpuSimd);
+
+} // namespace vca
@@ -23,10 +23,37 @@
 
 namespace vca {
 
+void processJob(const Job &job,
+                const vca_param &cfg,
+                const Primitives &primitives,
+                MultiThreadQueue<SharedFrameResult *> &results,
+                unsigned threadID)
+{
+    log(cfg,
+        LogLevel::Debug,
+        "Thread " + std::to_string(threadID) + ": Start work on job " + job.infoString());
+
+    auto &result = job.frameResult->result;
+    primitives.computeFeatures(job, result, cfg, primitives);
+
+    log(cfg,
+        LogLevel::Debug,
+        "Thread " + std::to_string(threadID) + ": Finished work on job " + job.infoString());
+
+    const auto nrBlockRows = job.macroblockRange.end - job.macroblockRange.start;
+    if (job.frameResult->nrBlockRowsPending.fetch_sub(nrBlockRows) > nrBlockRows)
+        return;
+
+    computeFrameAverages(result, cfg);
+    results.waitAndPushInOrder(job.frameResult, result.jobID);
+}
+
 ProcessingThread::ProcessingThread(vca_param cfg,
-                                   MultiThreadQueue<Job> &jobs,
-                                   MultiThreadQueue<Result> &results,
+                                   const Primitives &primitives,
+                                   JobScheduler &jobs,
+                                   MultiThreadQueue<SharedFrameResult *> &results,
                                    unsigned id)
+    : primitives(primitives)
 {
     this->cfg = cfg;
     this->id  = id;
@@ -37,53 +64,16 @@ ProcessingThread::ProcessingThread(vca_param cfg,
                                std::ref(results));
 }
 
-void ProcessingThread::threadFunction(MultiThreadQueue<Job> &jobQueue,
-                                      MultiThreadQueue<Result> &results)
+void ProcessingThread::threadFunction(JobScheduler &jobs,
+                                      MultiThreadQueue<SharedFrameResult *> &results)
 {
     while (!this->aborted)
     {
-        auto job = jobQueue.waitAndPop();
+        auto job = jobs.waitAndPop(this->id);
         if (!job)
             break;
 
-        log(this->cfg,
-            LogLevel::Debug,
-            "Thread " + std::to_string(this->id) + ": Start work on job " + job->infoString());
-
-        Result result;
-        result.poc   = job->frame->stats.poc;
-        result.jobID = job->jobID;
-        if (this->cfg.enableDCTenergy)
-        {
-            computeWeightedDCTEnergy(*job,
-                                     result,
-                                     this->cfg.blockSize,
-                                     this->cfg.cpuSimd,
-                                     this->cfg.enableEnergyChroma,
-                                     this->cfg.enableLowpass);
-        }
-        if (this->cfg.enableEntropy)
-        {
-            computeEntropy(*job,
-                           result,
-                           this->cfg.blockSize,
-                           this->cfg.cpuSimd,
-                           this->cfg.enableLowpass,
-                           this->cfg.enableEntropyChroma);
-        }
-        if (this->cfg.enableEdgeDensity)
-        {
-            computeEdgeDensity(*job,
-                               result,
-                               this->cfg.blockSize,
-                               this->cfg.cpuSimd,
-                               this->cfg.enableLowpass);
-        }
-        log(this->cfg,
-            LogLevel::Debug,
-            "Thread " + std::to_string(this->id) + ": Finished work on job " + job->infoString());
-
-        results.waitAndPushInOrder(result, result.jobID);
+        processJob(*job, this->cfg, this->primitives, results, this->id);
     }
 
     log(this->cfg, LogLevel::Debug, "Thread " + std::to_string(this->id) + " quit");
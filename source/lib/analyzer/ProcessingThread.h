@@ -18,22 +18,34 @@
 
 #pragma once
 
+#include <analyzer/JobScheduler.h>
 #include <analyzer/MultiThreadQueue.h>
+#include <analyzer/Primitives.h>
 #include <analyzer/common/common.h>
 #include <vcaLib.h>
 
+#include <atomic>
 #include <thread>
 
 namespace vca {
 
+// Analyze the block rows of the job. The thread that finishes the last rows of a frame pushes the
+// result of the frame.
+void processJob(const Job &job,
+                const vca_param &cfg,
+                const Primitives &primitives,
+                MultiThreadQueue<SharedFrameResult *> &results,
+                unsigned threadID);
+
 class ProcessingThread
 {
 public:
     ProcessingThread()                     = delete;
     ProcessingThread(ProcessingThread &&o) = delete;
     ProcessingThread(vca_param cfg,
-                     MultiThreadQueue<Job> &jobs,
-                     MultiThreadQueue<Result> &results,
+                     const Primitives &primitives,
+                     JobScheduler &jobs,
+                     MultiThreadQueue<SharedFrameResult *> &results,
                      unsigned id);
     ~ProcessingThread() = default;
 
@@ -41,12 +53,14 @@ public:
     void join();
 
 private:
-    void threadFunction(MultiThreadQueue<Job> &jobQueue, MultiThreadQueue<Result> &results);
+    void threadFunction(JobScheduler &jobs, MultiThreadQueue<SharedFrameResult *> &results);
 
     std::thread thread;
-    bool aborted{};
+    std::atomic<bool> aborted{};
     unsigned id{};
     vca_param cfg;
+    // Owned by the analyzer which only changes it before the first job
+    const Primitives &primitives;
 };
 
 } // namespace vca
@@ -0,0 +1,73 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "ResultPool.h"
+
+namespace vca {
+
+SharedFrameResult *ResultPool::acquire()
+{
+    std::unique_lock<std::mutex> lock(this->accessMutex);
+    if (!this->freeResults.empty())
+    {
+        auto result = this->freeResults.back();
+        this->freeResults.pop_back();
+        result->nrReferences = 1;
+        return result;
+    }
+
+    this->results.push_back(std::make_unique<SharedFrameResult>());
+    this->freeResults.reserve(this->results.size());
+    auto result          = this->results.back().get();
+    result->nrReferences = 1;
+    return result;
+}
+
+void ResultPool::release(SharedFrameResult *result)
+{
+    if (--result->nrReferences > 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(this->accessMutex);
+    this->freeResults.push_back(result);
+}
+
+void ResultPool::lend(SharedFrameResult *result)
+{
+    std::unique_lock<std::mutex> lock(this->accessMutex);
+    result->nrReferences++;
+    result->lent = true;
+}
+
+SharedFrameResult *ResultPool::takeBack(const vca_frame_results *view)
+{
+    std::unique_lock<std::mutex> lock(this->accessMutex);
+    for (const auto &result : this->results)
+    {
+        if (&result->view != view)
+            continue;
+        // Releasing a view twice would drop a reference that someone else holds
+        if (!result->lent)
+            return nullptr;
+        result->lent = false;
+        return result.get();
+    }
+    return nullptr;
+}
+
+} // namespace vca
@@ -0,0 +1,54 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <analyzer/common/common.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vca {
+
+// Owns all frame results. Results that were handed out are returned to the pool once all
+// references to them were released so that the per block vectors are only allocated once and
+// then reused.
+class ResultPool
+{
+public:
+    // Get a free result with one reference. A new result is only allocated if all results are
+    // in use.
+    SharedFrameResult *acquire();
+    // Drop one reference. The result is free again after the last reference was released.
+    void release(SharedFrameResult *result);
+
+    // Lend the view of the result to the user. This adds a reference.
+    void lend(SharedFrameResult *result);
+    // Take the view back from the user. Returns the result that the view belongs to or nullptr
+    // if the view is unknown or not lent out right now. The reference of the user must be
+    // released afterwards.
+    SharedFrameResult *takeBack(const vca_frame_results *view);
+
+private:
+    std::mutex accessMutex;
+    std::vector<std::unique_ptr<SharedFrameResult>> results;
+    std::vector<SharedFrameResult *> freeResults;
+};
+
+} // namespace vca
@@ -21,6 +21,7 @@
 #include <analyzer/common/EnumMapper.h>
 #include <vcaLib.h>
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <utility>
@@ -38,7 +39,9 @@ const auto CpuSimdMapper = EnumMapper<CpuSimd>({{CpuSimd::None, "NoSimd"},
                                                 {CpuSimd::SSE2, "SSE2"},
                                                 {CpuSimd::SSSE3, "SSSE3"},
                                                 {CpuSimd::SSE4, "SSE4"},
-                                                {CpuSimd::AVX2, "AVX2"}});
+                                                {CpuSimd::AVX2, "AVX2"},
+                                                {CpuSimd::AVX512, "AVX512"},
+                                                {CpuSimd::NEON, "NEON"}});
 
 inline void log(const vca_param &cfg, LogLevel level, const std::string &message)
 {
@@ -65,22 +68,38 @@ inline std::pair<unsigned, unsigned> getChromaFrameSizeInBlocks(unsigned blockSi
     return {widthInBlocks, heightInBlock};
 }
 
+// A range of block rows [start, end) in the luma plane
 struct MacroblockRange
 {
     unsigned start{};
     unsigned end{};
 };
 
+// The block rows of the chroma planes that belong to the given luma block rows. The mapping is
+// monotone, so the ranges of all slices of a frame cover each chroma block row exactly once.
+inline MacroblockRange getChromaBlockRowRange(const MacroblockRange &lumaRange,
+                                              unsigned heightInBlocks,
+                                              unsigned heightInBlocksChroma)
+{
+    return {lumaRange.start * heightInBlocksChroma / heightInBlocks,
+            lumaRange.end * heightInBlocksChroma / heightInBlocks};
+}
+
+struct SharedFrameResult;
+
 struct Job
 {
     vca_frame *frame;
     MacroblockRange macroblockRange;
     unsigned jobID;
 
-    std::string infoString()
+    // All slices of one frame write into the same result. It is owned by the ResultPool.
+    SharedFrameResult *frameResult{};
+
+    std::string infoString() const
     {
         return "Job " + std::to_string(this->jobID) + " POC "
-               + std::to_string(this->frame->stats.poc) + " MB "
+               + std::to_string(this->frame->stats.poc) + " block rows "
                + std::to_string(macroblockRange.start) + "-" + std::to_string(macroblockRange.end);
     }
 };
@@ -121,4 +140,18 @@ struct Result
     unsigned jobID{};
 };
 
+struct SharedFrameResult
+{
+    Result result;
+    // The thread that finishes the last block rows of the frame does the frame level calculations
+    std::atomic<unsigned> nrBlockRowsPending{};
+    // The analyzer holds a reference until the next frame was pulled and the user holds one
+    // while the result is lent out. The result goes back to the pool once both are released.
+    std::atomic<unsigned> nrReferences{};
+    // The view on the result that is lent to the user
+    vca_frame_results view{};
+    // If the view is lent to the user right now. Guarded by the mutex of the ResultPool.
+    bool lent{};
+};
+
 } // namespace vca
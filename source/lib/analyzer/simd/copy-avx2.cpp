@@ -0,0 +1,101 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "copy.h"
+
+#include <immintrin.h>
+
+namespace {
+
+// Load 16 samples as int16 values
+inline __m256i load16(const int16_t *src)
+{
+    return _mm256_loadu_si256((const __m256i *) src);
+}
+
+inline __m256i load16(const uint8_t *src)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) src));
+}
+
+template<typename Sample>
+void copyBlock(const Sample *src,
+               intptr_t srcStride,
+               unsigned blockSize,
+               unsigned paddingRight,
+               unsigned paddingBottom,
+               int16_t *dst)
+{
+    const auto width  = blockSize - paddingRight;
+    const auto height = blockSize - paddingBottom;
+
+    for (unsigned y = 0; y < height; y++, src += srcStride, dst += blockSize)
+    {
+        // Only whole vectors inside of the valid width are loaded
+        unsigned x = 0;
+        for (; x + 16 <= width; x += 16)
+            _mm256_storeu_si256((__m256i *) (dst + x), load16(src + x));
+        for (; x < width; x++)
+            dst[x] = int16_t(src[x]);
+
+        const auto lastValue = int16_t(src[width - 1]);
+        for (; x < blockSize && x % 16 != 0; x++)
+            dst[x] = lastValue;
+        const auto fill = _mm256_set1_epi16(lastValue);
+        for (; x < blockSize; x += 16)
+            _mm256_storeu_si256((__m256i *) (dst + x), fill);
+    }
+
+    const auto lastLine = dst - blockSize;
+    for (unsigned y = height; y < blockSize; y++, dst += blockSize)
+        for (unsigned x = 0; x < blockSize; x += 16)
+            _mm256_storeu_si256((__m256i *) (dst + x),
+                                _mm256_loadu_si256((const __m256i *) (lastLine + x)));
+}
+
+} // namespace
+
+void vca_copy_block_avx2(const int16_t *src,
+                         intptr_t srcStride,
+                         unsigned blockSize,
+                         unsigned paddingRight,
+                         unsigned paddingBottom,
+                         int16_t *dst)
+{
+    // The rows of 8x8 blocks are too short for the 256 bit registers
+    if (blockSize < 16)
+        vca_copy_block_sse2(src, srcStride, blockSize, paddingRight, paddingBottom, dst);
+    else
+        copyBlock(src, srcStride, blockSize, paddingRight, paddingBottom, dst);
+}
+
+void vca_copy_block_8bit_avx2(const uint8_t *src,
+                              intptr_t srcStride,
+                              unsigned blockSize,
+                              unsigned paddingRight,
+                              unsigned paddingBottom,
+                              int16_t *dst)
+{
+    if (blockSize < 16)
+        vca_copy_block_8bit_sse2(src, srcStride, blockSize, paddingRight, paddingBottom, dst);
+    else
+        copyBlock(src, srcStride, blockSize, paddingRight, paddingBottom, dst);
+}
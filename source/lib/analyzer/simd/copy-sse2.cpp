@@ -0,0 +1,94 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "copy.h"
+
+#include <emmintrin.h> // SSE2
+
+namespace {
+
+// Load 8 samples as int16 values
+inline __m128i load8(const int16_t *src)
+{
+    return _mm_loadu_si128((const __m128i *) src);
+}
+
+inline __m128i load8(const uint8_t *src)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) src), _mm_setzero_si128());
+}
+
+template<typename Sample>
+void copyBlock(const Sample *src,
+               intptr_t srcStride,
+               unsigned blockSize,
+               unsigned paddingRight,
+               unsigned paddingBottom,
+               int16_t *dst)
+{
+    const auto width  = blockSize - paddingRight;
+    const auto height = blockSize - paddingBottom;
+
+    for (unsigned y = 0; y < height; y++, src += srcStride, dst += blockSize)
+    {
+        // Never read past the last valid sample. The row may end at the end of the plane.
+        unsigned x = 0;
+        for (; x + 8 <= width; x += 8)
+            _mm_storeu_si128((__m128i *) (dst + x), load8(src + x));
+        for (; x < width; x++)
+            dst[x] = int16_t(src[x]);
+
+        const auto lastValue = int16_t(src[width - 1]);
+        for (; x < blockSize && x % 8 != 0; x++)
+            dst[x] = lastValue;
+        const auto fill = _mm_set1_epi16(lastValue);
+        for (; x < blockSize; x += 8)
+            _mm_storeu_si128((__m128i *) (dst + x), fill);
+    }
+
+    const auto lastLine = dst - blockSize;
+    for (unsigned y = height; y < blockSize; y++, dst += blockSize)
+        for (unsigned x = 0; x < blockSize; x += 8)
+            _mm_storeu_si128((__m128i *) (dst + x),
+                             _mm_loadu_si128((const __m128i *) (lastLine + x)));
+}
+
+} // namespace
+
+void vca_copy_block_sse2(const int16_t *src,
+                         intptr_t srcStride,
+                         unsigned blockSize,
+                         unsigned paddingRight,
+                         unsigned paddingBottom,
+                         int16_t *dst)
+{
+    copyBlock(src, srcStride, blockSize, paddingRight, paddingBottom, dst);
+}
+
+void vca_copy_block_8bit_sse2(const uint8_t *src,
+                              intptr_t srcStride,
+                              unsigned blockSize,
+                              unsigned paddingRight,
+                              unsigned paddingBottom,
+                              int16_t *dst)
+{
+    copyBlock(src, srcStride, blockSize, paddingRight, paddingBottom, dst);
+}
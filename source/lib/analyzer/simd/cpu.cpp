@@ -28,6 +28,11 @@
 #include <sys/sysctl.h>
 #include <sys/types.h>
 
+#endif
+#if VCA_ARCH_ARM64 && defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+
 #endif
 #if SYS_OPENBSD
 #include <machine/cpu.h>
@@ -146,12 +151,40 @@ CpuSimd cpuDetectMaxSimd()
             if (ebx & 0x00000020)
                 cpu = CpuSimd::AVX2;
         }
+        if (cpu == CpuSimd::AVX2 && (xcr0 & 0xE0) == 0xE0) /* OPMASK/ZMM state */
+        {
+            if ((ebx & 0x00010000) && (ebx & 0x40000000)) /* AVX-512 F and BW */
+                cpu = CpuSimd::AVX512;
+        }
     }
 #endif
     return cpu;
 }
 
+#elif VCA_ARCH_ARM64
+
+// NEON is the only SIMD level on ARM. It is not ordered with the x86 levels.
+bool isSimdSupported(CpuSimd simd)
+{
+    return simd == CpuSimd::None || simd == cpuDetectMaxSimd();
+}
+
+CpuSimd cpuDetectMaxSimd()
+{
+#if defined(__linux__)
+    if (!(getauxval(AT_HWCAP) & HWCAP_ASIMD))
+        return CpuSimd::None;
+#endif
+    // Advanced SIMD (NEON) is a mandatory part of ARMv8-A
+    return CpuSimd::NEON;
+}
+
 #else
+bool isSimdSupported(CpuSimd simd)
+{
+    return simd == CpuSimd::None;
+}
+
 CpuSimd cpuDetectMaxSimd()
 {
     return CpuSimd::None;
@@ -0,0 +1,179 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "dct-avx512.h"
+#include "dct-basis.h"
+
+#include <immintrin.h>
+
+#include <cstring>
+
+namespace {
+
+// The basis of the NxN DCT as pairs of neighboring values packed into int32. values[n][k] holds
+// the basis values 2n and 2n + 1 of basis function k, which is the operand layout of madd.
+template<unsigned N>
+struct BasisPairs
+{
+    BasisPairs()
+    {
+        for (unsigned n = 0; n < N / 2; n++)
+        {
+            for (unsigned k = 0; k < N; k++)
+            {
+                const auto first  = uint16_t(vca::dctBasisValue32(k * (32 / N), 2 * n));
+                const auto second = uint16_t(vca::dctBasisValue32(k * (32 / N), 2 * n + 1));
+                this->values[n][k] = int32_t(uint32_t(first) | (uint32_t(second) << 16));
+            }
+        }
+
+        // Permutation indices that interleave 16 values of two rows of N values
+        for (unsigned v = 0; v < N / 16; v++)
+        {
+            for (unsigned i = 0; i < 16; i++)
+            {
+                this->interleaveIndices[v][2 * i]     = int16_t(16 * v + i);
+                this->interleaveIndices[v][2 * i + 1] = int16_t(16 * v + i + N);
+            }
+        }
+    }
+
+    alignas(64) int32_t values[N / 2][N];
+    alignas(64) int16_t interleaveIndices[N / 16][32];
+};
+
+int32_t loadPair(const int16_t *src)
+{
+    int32_t pair;
+    std::memcpy(&pair, src, sizeof(pair));
+    return pair;
+}
+
+int32_t loadPair(const uint8_t *src)
+{
+    return int32_t(uint32_t(src[0]) | (uint32_t(src[1]) << 16));
+}
+
+__m512i roundAndShift(__m512i sums, __m512i add, __m128i shift)
+{
+    return _mm512_sra_epi32(_mm512_add_epi32(sums, add), shift);
+}
+
+// Both stages are matrix products with madd. The first stage transforms the source rows with 16
+// basis functions per register (one broadcast pair of source samples per madd) and writes the
+// result row wise into tmp. The second stage then works on 16 columns of tmp per register.
+template<unsigned N, typename Sample>
+void dct(const Sample *src, int16_t *dst, intptr_t srcStride, int shift1, int shift2)
+{
+    constexpr auto NR_VECTORS = N / 16;
+    static const BasisPairs<N> basis;
+
+    alignas(64) int16_t tmp[N * N];
+
+    const auto add1   = _mm512_set1_epi32(1 << (shift1 - 1));
+    const auto count1 = _mm_cvtsi32_si128(shift1);
+    for (unsigned j = 0; j < N; j++, src += srcStride)
+    {
+        __m512i sums[NR_VECTORS];
+        for (unsigned v = 0; v < NR_VECTORS; v++)
+            sums[v] = _mm512_setzero_si512();
+
+        for (unsigned n = 0; n < N / 2; n++)
+        {
+            const auto samples = _mm512_set1_epi32(loadPair(src + 2 * n));
+            for (unsigned v = 0; v < NR_VECTORS; v++)
+            {
+                const auto pairs = _mm512_load_si512((const void *) &basis.values[n][16 * v]);
+                sums[v]          = _mm512_add_epi32(sums[v], _mm512_madd_epi16(samples, pairs));
+            }
+        }
+
+        for (unsigned v = 0; v < NR_VECTORS; v++)
+            _mm256_store_si256((__m256i *) (tmp + j * N + 16 * v),
+                               _mm512_cvtsepi32_epi16(roundAndShift(sums[v], add1, count1)));
+    }
+
+    // Interleave the rows 2m and 2m + 1 of tmp so that madd can multiply them with a broadcast
+    // pair of basis values
+    alignas(64) int16_t interleaved[N / 2][NR_VECTORS][32];
+    for (unsigned v = 0; v < NR_VECTORS; v++)
+    {
+        const auto index = _mm512_load_si512((const void *) basis.interleaveIndices[v]);
+
+        for (unsigned m = 0; m < N / 2; m++)
+        {
+            const auto rows = tmp + 2 * m * N;
+            __m512i pairs;
+            if constexpr (N == 32)
+                pairs = _mm512_permutex2var_epi16(_mm512_load_si512((const void *) rows),
+                                                  index,
+                                                  _mm512_load_si512((const void *) (rows + N)));
+            else
+                pairs = _mm512_permutexvar_epi16(index, _mm512_load_si512((const void *) rows));
+            _mm512_store_si512((void *) interleaved[m][v], pairs);
+        }
+    }
+
+    const auto add2   = _mm512_set1_epi32(1 << (shift2 - 1));
+    const auto count2 = _mm_cvtsi32_si128(shift2);
+    for (unsigned k = 0; k < N; k++)
+    {
+        __m512i sums[NR_VECTORS];
+        for (unsigned v = 0; v < NR_VECTORS; v++)
+            sums[v] = _mm512_setzero_si512();
+
+        for (unsigned m = 0; m < N / 2; m++)
+        {
+            const auto basisPair = _mm512_set1_epi32(basis.values[m][k]);
+            for (unsigned v = 0; v < NR_VECTORS; v++)
+            {
+                const auto pairs = _mm512_load_si512((const void *) interleaved[m][v]);
+                sums[v] = _mm512_add_epi32(sums[v], _mm512_madd_epi16(pairs, basisPair));
+            }
+        }
+
+        for (unsigned v = 0; v < NR_VECTORS; v++)
+            _mm256_storeu_si256((__m256i *) (dst + k * N + 16 * v),
+                                _mm512_cvtsepi32_epi16(roundAndShift(sums[v], add2, count2)));
+    }
+}
+
+} // namespace
+
+void vca_dct16_avx512(const int16_t *src, int16_t *dst, intptr_t srcStride, unsigned bitDepth)
+{
+    dct<16>(src, dst, srcStride, 3 + int(bitDepth) - 8, 10);
+}
+
+void vca_dct32_avx512(const int16_t *src, int16_t *dst, intptr_t srcStride, unsigned bitDepth)
+{
+    dct<32>(src, dst, srcStride, 4 + int(bitDepth) - 8, 11);
+}
+
+void vca_dct16_8bit_avx512(const uint8_t *src, int16_t *dst, intptr_t srcStride)
+{
+    dct<16>(src, dst, srcStride, 3, 10);
+}
+
+void vca_dct32_8bit_avx512(const uint8_t *src, int16_t *dst, intptr_t srcStride)
+{
+    dct<32>(src, dst, srcStride, 4, 11);
+}
@@ -0,0 +1,33 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+// Forward DCTs using AVX-512 (F and BW). These do not depend on the bit depth at compile time.
+// The source rows do not have to be aligned. srcStride is given in samples.
+void vca_dct16_avx512(const int16_t *src, int16_t *dst, intptr_t srcStride, unsigned bitDepth);
+void vca_dct32_avx512(const int16_t *src, int16_t *dst, intptr_t srcStride, unsigned bitDepth);
+
+// Transforms of 8 bit samples which are widened while they are read
+void vca_dct16_8bit_avx512(const uint8_t *src, int16_t *dst, intptr_t srcStride);
+void vca_dct32_8bit_avx512(const uint8_t *src, int16_t *dst, intptr_t srcStride);
@@ -0,0 +1,51 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace vca {
+
+// The first column of the 32x32 DCT basis. All other basis values are one of these (or 0) with
+// a sign, because the integer basis keeps the symmetries of the cosines.
+constexpr int16_t DCT_FIRST_COLUMN_32[32] = {64, 90, 90, 90, 89, 88, 87, 85, 83, 82, 80,
+                                             78, 75, 73, 70, 67, 64, 61, 57, 54, 50, 46,
+                                             43, 38, 36, 31, 25, 22, 18, 13, 9,  4};
+
+// Basis value n of basis function k of the 32x32 DCT (cos(k * (2n + 1) * pi / 64)). The basis
+// functions of the NxN DCT are the basis functions k * (32 / N) of the 32x32 DCT.
+inline int16_t dctBasisValue32(unsigned k, unsigned n)
+{
+    if (k == 0)
+        return 64;
+
+    auto angle = (k * (2 * n + 1)) % 128;
+    if (angle > 64)
+        angle = 128 - angle;
+    if (angle == 32 || angle == 64)
+        return 0;
+    if (angle > 32)
+        return -DCT_FIRST_COLUMN_32[64 - angle];
+    return DCT_FIRST_COLUMN_32[angle];
+}
+
+} // namespace vca
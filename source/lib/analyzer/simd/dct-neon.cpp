@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "dct-basis.h"
+#include "dct-neon.h"
+
+#include <arm_neon.h>
+
+namespace {
+
+// The basis of the NxN DCT. The even basis functions are symmetric and the odd ones are
+// antisymmetric, so only the first N / 2 values of each basis function are needed. They are
+// applied to the sums (even) and differences (odd) of mirrored samples.
+template<unsigned N>
+struct Basis
+{
+    Basis()
+    {
+        for (unsigned k = 0; k < N; k++)
+            for (unsigned n = 0; n < N / 2; n++)
+                this->rows[k][n] = vca::dctBasisValue32(k * (32 / N), n);
+
+        for (unsigned n = 0; n < N / 2; n++)
+        {
+            for (unsigned i = 0; i < N / 2; i++)
+            {
+                this->even[n][i] = this->rows[2 * i][n];
+                this->odd[n][i]  = this->rows[2 * i + 1][n];
+            }
+        }
+    }
+
+    // rows[k][n] is the value n of basis function k
+    int32_t rows[N][N / 2];
+
+    // even[n][i] and odd[n][i] are the value n of the basis functions 2i and 2i + 1
+    int32_t even[N / 2][N / 2];
+    int32_t odd[N / 2][N / 2];
+};
+
+void widen(int16x8_t samples, int32x4_t *dst)
+{
+    dst[0] = vmovl_s16(vget_low_s16(samples));
+    dst[1] = vmovl_high_s16(samples);
+}
+
+template<unsigned N>
+void loadRow(const int16_t *src, int32x4_t *row)
+{
+    for (unsigned i = 0; i < N / 8; i++)
+        widen(vld1q_s16(src + 8 * i), row + 2 * i);
+}
+
+template<unsigned N>
+void loadRow(const uint8_t *src, int32x4_t *row)
+{
+    for (unsigned i = 0; i < N / 8; i++)
+        widen(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src + 8 * i))), row + 2 * i);
+}
+
+int32x4_t reverse(int32x4_t values)
+{
+    const auto swapped = vrev64q_s32(values);
+    return vextq_s32(swapped, swapped, 2);
+}
+
+// sums[v] += basis[l][4v..4v+3] * values[l] for the 4 lanes l of values
+template<unsigned N>
+void multiplyAccumulate(int32x4_t *sums, const int32_t (*basis)[N / 2], int32x4_t values)
+{
+    for (unsigned v = 0; v < N / 8; v++)
+    {
+        sums[v] = vmlaq_laneq_s32(sums[v], vld1q_s32(&basis[0][4 * v]), values, 0);
+        sums[v] = vmlaq_laneq_s32(sums[v], vld1q_s32(&basis[1][4 * v]), values, 1);
+        sums[v] = vmlaq_laneq_s32(sums[v], vld1q_s32(&basis[2][4 * v]), values, 2);
+        sums[v] = vmlaq_laneq_s32(sums[v], vld1q_s32(&basis[3][4 * v]), values, 3);
+    }
+}
+
+// (sums + (1 << (shift - 1))) >> shift saturated to int16. The shift is given as a negative
+// shift left.
+int16x4_t roundAndShift(int32x4_t sums, int32x4_t negativeShift)
+{
+    return vqmovn_s32(vrshlq_s32(sums, negativeShift));
+}
+
+template<unsigned N, typename Sample>
+void dct(const Sample *src, int16_t *dst, intptr_t srcStride, int shift1, int shift2)
+{
+    static const Basis<N> basis;
+
+    // The first stage transforms the rows. The results of the even and the odd basis functions
+    // are written to the left and the right half of the rows of tmp.
+    int16_t tmp[N * N];
+
+    const auto negativeShift1 = vdupq_n_s32(-shift1);
+    for (unsigned j = 0; j < N; j++, src += srcStride)
+    {
+        int32x4_t row[N / 4];
+        loadRow<N>(src, row);
+
+        int32x4_t evenSums[N / 8];
+        int32x4_t oddSums[N / 8];
+        for (unsigned v = 0; v < N / 8; v++)
+        {
+            evenSums[v] = vdupq_n_s32(0);
+            oddSums[v]  = vdupq_n_s32(0);
+        }
+
+        for (unsigned m = 0; m < N / 8; m++)
+        {
+            const auto mirrored = reverse(row[N / 4 - 1 - m]);
+            multiplyAccumulate<N>(evenSums, &basis.even[4 * m], vaddq_s32(row[m], mirrored));
+            multiplyAccumulate<N>(oddSums, &basis.odd[4 * m], vsubq_s32(row[m], mirrored));
+        }
+
+        for (unsigned v = 0; v < N / 8; v++)
+        {
+            vst1_s16(tmp + j * N + 4 * v, roundAndShift(evenSums[v], negativeShift1));
+            vst1_s16(tmp + j * N + N / 2 + 4 * v, roundAndShift(oddSums[v], negativeShift1));
+        }
+    }
+
+    // The second stage transforms the columns. Each output row is a weighted sum of the rows of
+    // tmp, which are split into the sums and differences of mirrored rows in the same way.
+    int32x4_t evenRows[N / 2][N / 4];
+    int32x4_t oddRows[N / 2][N / 4];
+    for (unsigned j = 0; j < N / 2; j++)
+    {
+        for (unsigned i = 0; i < N / 8; i++)
+        {
+            const auto top    = vld1q_s16(tmp + j * N + 8 * i);
+            const auto bottom = vld1q_s16(tmp + (N - 1 - j) * N + 8 * i);
+
+            evenRows[j][2 * i]     = vaddl_s16(vget_low_s16(top), vget_low_s16(bottom));
+            evenRows[j][2 * i + 1] = vaddl_high_s16(top, bottom);
+            oddRows[j][2 * i]      = vsubl_s16(vget_low_s16(top), vget_low_s16(bottom));
+            oddRows[j][2 * i + 1]  = vsubl_high_s16(top, bottom);
+        }
+    }
+
+    const auto negativeShift2 = vdupq_n_s32(-shift2);
+    for (unsigned k = 0; k < N; k++)
+    {
+        const auto &rows = (k % 2 == 0) ? evenRows : oddRows;
+
+        int32x4_t sums[N / 4];
+        for (unsigned v = 0; v < N / 4; v++)
+            sums[v] = vdupq_n_s32(0);
+
+        for (unsigned j = 0; j < N / 2; j++)
+            for (unsigned v = 0; v < N / 4; v++)
+                sums[v] = vmlaq_n_s32(sums[v], rows[j][v], basis.rows[k][j]);
+
+        // The first half of the sums are the even and the second half the odd columns. Storing
+        // them interleaved restores the order of the columns.
+        if constexpr (N == 8)
+        {
+            int16x4x2_t columns;
+            columns.val[0] = roundAndShift(sums[0], negativeShift2);
+            columns.val[1] = roundAndShift(sums[1], negativeShift2);
+            vst2_s16(dst + k * N, columns);
+        }
+        else
+        {
+            for (unsigned i = 0; i < N / 16; i++)
+            {
+                const auto even = sums + 2 * i;
+                const auto odd  = sums + N / 8 + 2 * i;
+
+                int16x8x2_t columns;
+                columns.val[0] = vcombine_s16(roundAndShift(even[0], negativeShift2),
+                                              roundAndShift(even[1], negativeShift2));
+                columns.val[1] = vcombine_s16(roundAndShift(odd[0], negativeShift2),
+                                              roundAndShift(odd[1], negativeShift2));
+                vst2q_s16(dst + k * N + 16 * i, columns);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void vca_dct8_neon(const int16_t *src, int16_t *dst, intptr_t srcStride, unsigned bitDepth)
+{
+    dct<8>(src, dst, srcStride, 2 + int(bitDepth) - 8, 9);
+}
+
+void vca_dct16_neon(const int16_t *src, int16_t *dst, intptr_t srcStride, unsigned bitDepth)
+{
+    dct<16>(src, dst, srcStride, 3 + int(bitDepth) - 8, 10);
+}
+
+void vca_dct32_neon(const int16_t *src, int16_t *dst, intptr_t srcStride, unsigned bitDepth)
+{
+    dct<32>(src, dst, srcStride, 4 + int(bitDepth) - 8, 11);
+}
+
+void vca_dct8_8bit_neon(const uint8_t *src, int16_t *dst, intptr_t srcStride)
+{
+    dct<8>(src, dst, srcStride, 2, 9);
+}
+
+void vca_dct16_8bit_neon(const uint8_t *src, int16_t *dst, intptr_t srcStride)
+{
+    dct<16>(src, dst, srcStride, 3, 10);
+}
+
+void vca_dct32_8bit_neon(const uint8_t *src, int16_t *dst, intptr_t srcStride)
+{
+    dct<32>(src, dst, srcStride, 4, 11);
+}
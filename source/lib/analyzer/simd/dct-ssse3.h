@@ -28,3 +28,7 @@ void vca_dct16_12bit_ssse3(const int16_t *src, int16_t *dst, intptr_t srcStride)
 void vca_dct32_8bit_ssse3(const int16_t *src, int16_t *dst, intptr_t stride);
 void vca_dct32_10bit_ssse3(const int16_t *src, int16_t *dst, intptr_t stride);
 void vca_dct32_12bit_ssse3(const int16_t *src, int16_t *dst, intptr_t stride);
+
+// Transforms of 8 bit samples which are widened while they are read. No alignment is required.
+void vca_dct16_8bit_ssse3(const uint8_t *src, int16_t *dst, intptr_t srcStride);
+void vca_dct32_8bit_ssse3(const uint8_t *src, int16_t *dst, intptr_t stride);
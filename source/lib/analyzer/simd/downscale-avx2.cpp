@@ -0,0 +1,91 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "downscale.h"
+
+#include <immintrin.h>
+
+namespace {
+
+// Load 16 samples as int16 values
+inline __m256i load16(const int16_t *src)
+{
+    return _mm256_loadu_si256((const __m256i *) src);
+}
+
+inline __m256i load16(const uint8_t *src)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) src));
+}
+
+template<typename Sample>
+int32_t downscale(const Sample *src, intptr_t srcStride, unsigned blockSize, int16_t *dst)
+{
+    const auto ones = _mm256_set1_epi16(1);
+    auto totalSum   = _mm256_setzero_si256();
+    for (unsigned y = 0; y < blockSize; y += 2, src += 2 * srcStride)
+    {
+        // Each step reduces 16 samples of 2 rows to 8 samples
+        for (unsigned x = 0; x < blockSize; x += 16, dst += 8)
+        {
+            const auto row0 = load16(src + x);
+            const auto row1 = load16(src + srcStride + x);
+            const auto sums = _mm256_add_epi32(_mm256_madd_epi16(row0, ones),
+                                               _mm256_madd_epi16(row1, ones));
+            totalSum        = _mm256_add_epi32(totalSum, sums);
+
+            // Packing works within the 128 bit lanes. Gather the low halves of both lanes.
+            const auto average = _mm256_srai_epi32(sums, 2);
+            const auto packed  = _mm256_permute4x64_epi64(_mm256_packs_epi32(average, average),
+                                                         _MM_SHUFFLE(3, 1, 2, 0));
+            _mm_storeu_si128((__m128i *) dst, _mm256_castsi256_si128(packed));
+        }
+    }
+
+    auto sum128 = _mm_add_epi32(_mm256_castsi256_si128(totalSum),
+                                _mm256_extracti128_si256(totalSum, 1));
+    sum128      = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum128      = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum128);
+}
+
+} // namespace
+
+int32_t vca_downscale_2x2_avx2(const int16_t *src,
+                               intptr_t srcStride,
+                               unsigned blockSize,
+                               int16_t *dst)
+{
+    // The rows of 8x8 blocks are too short for the 256 bit registers
+    if (blockSize < 16)
+        return vca_downscale_2x2_sse2(src, srcStride, blockSize, dst);
+    return downscale(src, srcStride, blockSize, dst);
+}
+
+int32_t vca_downscale_2x2_8bit_avx2(const uint8_t *src,
+                                    intptr_t srcStride,
+                                    unsigned blockSize,
+                                    int16_t *dst)
+{
+    if (blockSize < 16)
+        return vca_downscale_2x2_8bit_sse2(src, srcStride, blockSize, dst);
+    return downscale(src, srcStride, blockSize, dst);
+}
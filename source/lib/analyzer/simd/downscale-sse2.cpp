@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "downscale.h"
+
+#include <emmintrin.h> // SSE2
+
+namespace {
+
+// Load 8 samples as int16 values
+inline __m128i load8(const int16_t *src)
+{
+    return _mm_loadu_si128((const __m128i *) src);
+}
+
+inline __m128i load8(const uint8_t *src)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) src), _mm_setzero_si128());
+}
+
+template<typename Sample>
+int32_t downscale(const Sample *src, intptr_t srcStride, unsigned blockSize, int16_t *dst)
+{
+    const auto ones = _mm_set1_epi16(1);
+    auto totalSum   = _mm_setzero_si128();
+    for (unsigned y = 0; y < blockSize; y += 2, src += 2 * srcStride)
+    {
+        // Each step reduces 8 samples of 2 rows to 4 samples
+        for (unsigned x = 0; x < blockSize; x += 8, dst += 4)
+        {
+            const auto row0 = load8(src + x);
+            const auto row1 = load8(src + srcStride + x);
+            const auto sums = _mm_add_epi32(_mm_madd_epi16(row0, ones), _mm_madd_epi16(row1, ones));
+            totalSum        = _mm_add_epi32(totalSum, sums);
+
+            const auto average = _mm_srai_epi32(sums, 2);
+            _mm_storel_epi64((__m128i *) dst, _mm_packs_epi32(average, average));
+        }
+    }
+
+    totalSum = _mm_add_epi32(totalSum, _mm_shuffle_epi32(totalSum, _MM_SHUFFLE(1, 0, 3, 2)));
+    totalSum = _mm_add_epi32(totalSum, _mm_shuffle_epi32(totalSum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(totalSum);
+}
+
+} // namespace
+
+int32_t vca_downscale_2x2_sse2(const int16_t *src,
+                               intptr_t srcStride,
+                               unsigned blockSize,
+                               int16_t *dst)
+{
+    return downscale(src, srcStride, blockSize, dst);
+}
+
+int32_t vca_downscale_2x2_8bit_sse2(const uint8_t *src,
+                                    intptr_t srcStride,
+                                    unsigned blockSize,
+                                    int16_t *dst)
+{
+    return downscale(src, srcStride, blockSize, dst);
+}
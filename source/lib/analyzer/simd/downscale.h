@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+// Downscale a block by averaging 2x2 samples into the (blockSize / 2) x (blockSize / 2) block
+// dst. Returns the sum of all samples of the source block. srcStride is given in samples.
+int32_t vca_downscale_2x2_sse2(const int16_t *src,
+                               intptr_t srcStride,
+                               unsigned blockSize,
+                               int16_t *dst);
+int32_t vca_downscale_2x2_avx2(const int16_t *src,
+                               intptr_t srcStride,
+                               unsigned blockSize,
+                               int16_t *dst);
+
+// The same for 8 bit samples which are widened while they are read
+int32_t vca_downscale_2x2_8bit_sse2(const uint8_t *src,
+                                    intptr_t srcStride,
+                                    unsigned blockSize,
+                                    int16_t *dst);
+int32_t vca_downscale_2x2_8bit_avx2(const uint8_t *src,
+                                    intptr_t srcStride,
+                                    unsigned blockSize,
+                                    int16_t *dst);
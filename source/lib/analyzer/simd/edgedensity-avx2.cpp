@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "edgedensity.h"
+
+#include <immintrin.h>
+
+namespace {
+
+// Shift the 16 samples by one towards the lower lanes. The top lane becomes 0.
+inline __m256i shiftInNextSample(__m256i samples)
+{
+    const auto upperHalf = _mm256_permute2x128_si256(samples, samples, 0x81);
+    return _mm256_alignr_epi8(upperHalf, samples, 2);
+}
+
+} // namespace
+
+uint32_t vca_edge_count_avx2(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold)
+{
+    // The rows of 8x8 blocks are too short for the 256 bit registers
+    if (blockSize < 16)
+        return vca_edge_count_ssse3(pixelBuffer, blockSize, threshold);
+
+    const auto thresholds    = _mm256_set1_epi16(threshold);
+    const auto notLastSample = shiftInNextSample(_mm256_set1_epi16(-1));
+
+    auto edgeCounts = _mm256_setzero_si256();
+    for (unsigned y = 0; y < blockSize; y++)
+    {
+        const auto row = pixelBuffer + y * blockSize;
+        for (unsigned x = 0; x < blockSize; x += 16)
+        {
+            const auto samples   = _mm256_loadu_si256((const __m256i *) (row + x));
+            const auto lastChunk = x + 16 == blockSize;
+
+            const auto right = lastChunk ? shiftInNextSample(samples)
+                                         : _mm256_loadu_si256((const __m256i *) (row + x + 1));
+            const auto diff  = _mm256_abs_epi16(_mm256_sub_epi16(samples, right));
+            auto horizontal  = _mm256_cmpgt_epi16(diff, thresholds);
+            if (lastChunk)
+                horizontal = _mm256_and_si256(horizontal, notLastSample);
+            edgeCounts = _mm256_sub_epi16(edgeCounts, horizontal);
+
+            if (y + 1 < blockSize)
+            {
+                const auto below    = _mm256_loadu_si256((const __m256i *) (row + blockSize + x));
+                const auto diffY    = _mm256_abs_epi16(_mm256_sub_epi16(samples, below));
+                const auto vertical = _mm256_cmpgt_epi16(diffY, thresholds);
+                edgeCounts          = _mm256_sub_epi16(edgeCounts, vertical);
+            }
+        }
+    }
+
+    const auto sum256 = _mm256_madd_epi16(edgeCounts, _mm256_set1_epi16(1));
+    auto sum          = _mm_add_epi32(_mm256_castsi256_si128(sum256),
+                                      _mm256_extracti128_si256(sum256, 1));
+    sum               = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum               = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return uint32_t(_mm_cvtsi128_si32(sum));
+}
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "edgedensity.h"
+
+#include <arm_neon.h>
+
+namespace {
+
+// |a - b| > threshold. The absolute difference of two int16 values fits into uint16.
+inline uint16x8_t isEdge(int16x8_t a, int16x8_t b, uint16x8_t thresholds)
+{
+    return vcgtq_u16(vreinterpretq_u16_s16(vabdq_s16(a, b)), thresholds);
+}
+
+} // namespace
+
+uint32_t vca_edge_count_neon(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold)
+{
+    const uint16_t notLastSampleValues[8] = {0xffff, 0xffff, 0xffff, 0xffff,
+                                             0xffff, 0xffff, 0xffff, 0};
+
+    const auto thresholds    = vdupq_n_u16(uint16_t(threshold));
+    const auto notLastSample = vld1q_u16(notLastSampleValues);
+
+    auto edgeCounts = vdupq_n_u16(0);
+    for (unsigned y = 0; y < blockSize; y++)
+    {
+        const auto row = pixelBuffer + y * blockSize;
+        for (unsigned x = 0; x < blockSize; x += 8)
+        {
+            const auto samples   = vld1q_s16(row + x);
+            const auto lastChunk = x + 8 == blockSize;
+
+            // The right neighbor of the last sample of the row is not part of the block
+            const auto right = lastChunk ? vextq_s16(samples, samples, 1) : vld1q_s16(row + x + 1);
+            auto horizontal  = isEdge(samples, right, thresholds);
+            if (lastChunk)
+                horizontal = vandq_u16(horizontal, notLastSample);
+            edgeCounts = vsubq_u16(edgeCounts, horizontal);
+
+            if (y + 1 < blockSize)
+            {
+                const auto below = vld1q_s16(row + blockSize + x);
+                edgeCounts       = vsubq_u16(edgeCounts, isEdge(samples, below, thresholds));
+            }
+        }
+    }
+
+    return vaddlvq_u16(edgeCounts);
+}
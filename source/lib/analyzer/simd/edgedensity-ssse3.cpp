@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "edgedensity.h"
+
+#include <tmmintrin.h> // SSSE3
+
+uint32_t vca_edge_count_ssse3(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold)
+{
+    const auto thresholds = _mm_set1_epi16(threshold);
+    // The last sample of a row has no right neighbor
+    const auto notLastSample = _mm_srli_si128(_mm_set1_epi16(-1), 2);
+
+    // Each lane counts its edges by subtracting the compare masks (-1 for an edge)
+    auto edgeCounts = _mm_setzero_si128();
+    for (unsigned y = 0; y < blockSize; y++)
+    {
+        const auto row = pixelBuffer + y * blockSize;
+        for (unsigned x = 0; x < blockSize; x += 8)
+        {
+            const auto samples   = _mm_loadu_si128((const __m128i *) (row + x));
+            const auto lastChunk = x + 8 == blockSize;
+
+            // The right neighbors of the last chunk are shifted in so that no sample past the
+            // end of the block is read
+            const auto right = lastChunk ? _mm_srli_si128(samples, 2)
+                                         : _mm_loadu_si128((const __m128i *) (row + x + 1));
+            const auto diff  = _mm_abs_epi16(_mm_sub_epi16(samples, right));
+            auto horizontal  = _mm_cmpgt_epi16(diff, thresholds);
+            if (lastChunk)
+                horizontal = _mm_and_si128(horizontal, notLastSample);
+            edgeCounts = _mm_sub_epi16(edgeCounts, horizontal);
+
+            if (y + 1 < blockSize)
+            {
+                const auto below    = _mm_loadu_si128((const __m128i *) (row + blockSize + x));
+                const auto diffY    = _mm_abs_epi16(_mm_sub_epi16(samples, below));
+                const auto vertical = _mm_cmpgt_epi16(diffY, thresholds);
+                edgeCounts          = _mm_sub_epi16(edgeCounts, vertical);
+            }
+        }
+    }
+
+    auto sum = _mm_madd_epi16(edgeCounts, _mm_set1_epi16(1));
+    sum      = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum      = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return uint32_t(_mm_cvtsi128_si32(sum));
+}
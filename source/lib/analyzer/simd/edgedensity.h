@@ -19,16 +19,12 @@
  * along with this program.
  *****************************************************************************/
 
-#include <immintrin.h> // Include SIMD intrinsics header for x86 architecture
-#include <cmath>
-#include <vector>
-#include <unordered_map>
+#pragma once
 
-// x86 SIMD optimized entropy function
+#include <stdint.h>
 
-double entropy_avx2(const std::vector<int16_t> &block)
-{
-    //TODO
-    double entropy = 0.0;
-    return entropy;
-}
+// Count the pairs of horizontally and vertically neighboring samples of the block whose absolute
+// difference is above the threshold. The block has a stride of blockSize.
+uint32_t vca_edge_count_ssse3(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold);
+uint32_t vca_edge_count_avx2(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold);
+uint32_t vca_edge_count_neon(const int16_t *pixelBuffer, unsigned blockSize, int16_t threshold);
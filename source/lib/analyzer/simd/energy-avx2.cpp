@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "energy.h"
+
+#include <immintrin.h>
+
+namespace {
+
+// (weight * |coeff|) >> 8 for 16 values. The weights are below 256 so the shifted product of the
+// unsigned 16 bit values still fits into 15 bits.
+__m256i weightedAbs(__m256i coeff, __m256i weights)
+{
+    const auto absCoeff = _mm256_abs_epi16(coeff);
+    const auto low      = _mm256_mullo_epi16(absCoeff, weights);
+    const auto high     = _mm256_mulhi_epu16(absCoeff, weights);
+    return _mm256_or_si256(_mm256_srli_epi16(low, 8), _mm256_slli_epi16(high, 8));
+}
+
+__m256i loadTwoRows(const int16_t *src, unsigned stride)
+{
+    const auto row0 = _mm_loadu_si128((const __m128i *) src);
+    const auto row1 = _mm_loadu_si128((const __m128i *) (src + stride));
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(row0), row1, 1);
+}
+
+} // namespace
+
+uint32_t vca_weighted_coeff_sum_avx2(const int16_t *coeff,
+                                     const int16_t *weights,
+                                     unsigned stride,
+                                     unsigned size)
+{
+    const auto ones = _mm256_set1_epi16(1);
+    auto sum        = _mm256_setzero_si256();
+    if (size == 8)
+    {
+        // Two rows of 8 coefficients per register
+        for (unsigned y = 0; y < size; y += 2, coeff += 2 * stride, weights += 2 * stride)
+        {
+            const auto c = loadTwoRows(coeff, stride);
+            const auto w = loadTwoRows(weights, stride);
+            sum          = _mm256_add_epi32(sum, _mm256_madd_epi16(weightedAbs(c, w), ones));
+        }
+    }
+    else
+    {
+        for (unsigned y = 0; y < size; y++, coeff += stride, weights += stride)
+        {
+            for (unsigned x = 0; x < size; x += 16)
+            {
+                const auto c = _mm256_loadu_si256((const __m256i *) (coeff + x));
+                const auto w = _mm256_loadu_si256((const __m256i *) (weights + x));
+                sum = _mm256_add_epi32(sum, _mm256_madd_epi16(weightedAbs(c, w), ones));
+            }
+        }
+    }
+
+    auto sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    sum128      = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum128      = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(2, 3, 0, 1)));
+    return uint32_t(_mm_cvtsi128_si32(sum128));
+}
@@ -0,0 +1,81 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "energy.h"
+
+#include <immintrin.h>
+
+namespace {
+
+// (weight * |coeff|) >> 8 for 32 values (see energy-avx2.cpp)
+__m512i weightedAbs(__m512i coeff, __m512i weights)
+{
+    const auto absCoeff = _mm512_abs_epi16(coeff);
+    const auto low      = _mm512_mullo_epi16(absCoeff, weights);
+    const auto high     = _mm512_mulhi_epu16(absCoeff, weights);
+    return _mm512_or_si512(_mm512_srli_epi16(low, 8), _mm512_slli_epi16(high, 8));
+}
+
+__m512i loadTwoRows(const int16_t *src, unsigned stride)
+{
+    const auto row0 = _mm256_loadu_si256((const __m256i *) src);
+    const auto row1 = _mm256_loadu_si256((const __m256i *) (src + stride));
+    return _mm512_inserti64x4(_mm512_castsi256_si512(row0), row1, 1);
+}
+
+} // namespace
+
+uint32_t vca_weighted_coeff_sum_avx512(const int16_t *coeff,
+                                       const int16_t *weights,
+                                       unsigned stride,
+                                       unsigned size)
+{
+    // Rows of 8 coefficients are too short for the 512 bit registers
+    if (size == 8)
+        return vca_weighted_coeff_sum_avx2(coeff, weights, stride, size);
+
+    const auto ones = _mm512_set1_epi16(1);
+    auto sum        = _mm512_setzero_si512();
+    if (size == 16)
+    {
+        // Two rows of 16 coefficients per register
+        for (unsigned y = 0; y < size; y += 2, coeff += 2 * stride, weights += 2 * stride)
+        {
+            const auto c = loadTwoRows(coeff, stride);
+            const auto w = loadTwoRows(weights, stride);
+            sum          = _mm512_add_epi32(sum, _mm512_madd_epi16(weightedAbs(c, w), ones));
+        }
+    }
+    else
+    {
+        for (unsigned y = 0; y < size; y++, coeff += stride, weights += stride)
+        {
+            for (unsigned x = 0; x < size; x += 32)
+            {
+                const auto c = _mm512_loadu_si512((const void *) (coeff + x));
+                const auto w = _mm512_loadu_si512((const void *) (weights + x));
+                sum = _mm512_add_epi32(sum, _mm512_madd_epi16(weightedAbs(c, w), ones));
+            }
+        }
+    }
+
+    return uint32_t(_mm512_reduce_add_epi32(sum));
+}
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "energy.h"
+
+#include <arm_neon.h>
+
+uint32_t vca_weighted_coeff_sum_neon(const int16_t *coeff,
+                                     const int16_t *weights,
+                                     unsigned stride,
+                                     unsigned size)
+{
+    // The absolute value of -32768 wraps to itself, which is correct when read as unsigned
+    auto sum = vdupq_n_u32(0);
+    for (unsigned y = 0; y < size; y++, coeff += stride, weights += stride)
+    {
+        for (unsigned x = 0; x < size; x += 8)
+        {
+            const auto c = vreinterpretq_u16_s16(vabsq_s16(vld1q_s16(coeff + x)));
+            const auto w = vreinterpretq_u16_s16(vld1q_s16(weights + x));
+            sum          = vsraq_n_u32(sum, vmull_u16(vget_low_u16(c), vget_low_u16(w)), 8);
+            sum          = vsraq_n_u32(sum, vmull_high_u16(c, w), 8);
+        }
+    }
+
+    return vaddvq_u32(sum);
+}
@@ -0,0 +1,60 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "energy.h"
+
+#include <tmmintrin.h> // SSSE3
+
+namespace {
+
+// (weight * |coeff|) >> 8 for 8 values. The weights are below 256 so the shifted product of the
+// unsigned 16 bit values still fits into 15 bits.
+__m128i weightedAbs(__m128i coeff, __m128i weights)
+{
+    const auto absCoeff = _mm_abs_epi16(coeff);
+    const auto low      = _mm_mullo_epi16(absCoeff, weights);
+    const auto high     = _mm_mulhi_epu16(absCoeff, weights);
+    return _mm_or_si128(_mm_srli_epi16(low, 8), _mm_slli_epi16(high, 8));
+}
+
+} // namespace
+
+uint32_t vca_weighted_coeff_sum_ssse3(const int16_t *coeff,
+                                      const int16_t *weights,
+                                      unsigned stride,
+                                      unsigned size)
+{
+    const auto ones = _mm_set1_epi16(1);
+    auto sum        = _mm_setzero_si128();
+    for (unsigned y = 0; y < size; y++, coeff += stride, weights += stride)
+    {
+        for (unsigned x = 0; x < size; x += 8)
+        {
+            const auto c = _mm_loadu_si128((const __m128i *) (coeff + x));
+            const auto w = _mm_loadu_si128((const __m128i *) (weights + x));
+            sum          = _mm_add_epi32(sum, _mm_madd_epi16(weightedAbs(c, w), ones));
+        }
+    }
+
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return uint32_t(_mm_cvtsi128_si32(sum));
+}
@@ -0,0 +1,43 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+// Weighted sum of the absolute DCT coefficients: sum of (weight * |coeff|) >> 8 over the top
+// left size x size coefficients. The coefficients and the weights have the same stride.
+uint32_t vca_weighted_coeff_sum_ssse3(const int16_t *coeff,
+                                      const int16_t *weights,
+                                      unsigned stride,
+                                      unsigned size);
+uint32_t vca_weighted_coeff_sum_avx2(const int16_t *coeff,
+                                     const int16_t *weights,
+                                     unsigned stride,
+                                     unsigned size);
+uint32_t vca_weighted_coeff_sum_avx512(const int16_t *coeff,
+                                       const int16_t *weights,
+                                       unsigned stride,
+                                       unsigned size);
+uint32_t vca_weighted_coeff_sum_neon(const int16_t *coeff,
+                                     const int16_t *weights,
+                                     unsigned stride,
+                                     unsigned size);
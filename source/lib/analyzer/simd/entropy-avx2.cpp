@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "entropy-histogram.h"
+#include "entropy.h"
+
+#include <immintrin.h>
+
+#ifndef BIT_DEPTH
+#error "BIT_DEPTH must be specified"
+#endif
+
+#if defined(__GNUC__)
+#define ALIGN_VAR_32(T, var) T var __attribute__((aligned(32)))
+#elif defined(_MSC_VER)
+#define ALIGN_VAR_32(T, var) __declspec(align(32)) T var
+#endif
+
+namespace {
+
+using Histograms = vca::EntropyHistograms<BIT_DEPTH>;
+
+constexpr int MAX_SAMPLE_VALUE = Histograms::MAX_SAMPLE_VALUE;
+
+// Filled on the first call of the kernel, when AVX2 is known to be available
+const double *getEntropyTable()
+{
+    static const vca::EntropyTable table;
+    return table.values;
+}
+
+int16_t horizontalMin(__m256i values)
+{
+    auto v = _mm_min_epi16(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+    v      = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v      = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v      = _mm_min_epi16(v, _mm_srli_epi32(v, 16));
+    return static_cast<int16_t>(_mm_extract_epi16(v, 0));
+}
+
+int16_t horizontalMax(__m256i values)
+{
+    auto v = _mm_max_epi16(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+    v      = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v      = _mm_max_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v      = _mm_max_epi16(v, _mm_srli_epi32(v, 16));
+    return static_cast<int16_t>(_mm_extract_epi16(v, 0));
+}
+
+// The number of samples must be a power of two and at least 16.
+double calculateEntropy(const int16_t *samples, const unsigned nrSamples)
+{
+    auto minVec = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples));
+    auto maxVec = minVec;
+    for (unsigned i = 16; i < nrSamples; i += 16)
+    {
+        const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples + i));
+        minVec       = _mm256_min_epi16(minVec, v);
+        maxVec       = _mm256_max_epi16(maxVec, v);
+    }
+    int minValue = horizontalMin(minVec);
+    int maxValue = horizontalMax(maxVec);
+
+    // Samples outside of the range of the bit depth are clamped so that they fit the histogram
+    ALIGN_VAR_32(int16_t, clampedSamples[vca::ENTROPY_MAX_SAMPLES]);
+    if (minValue < 0 || maxValue > MAX_SAMPLE_VALUE)
+    {
+        const auto lower = _mm256_setzero_si256();
+        const auto upper = _mm256_set1_epi16(MAX_SAMPLE_VALUE);
+        for (unsigned i = 0; i < nrSamples; i += 16)
+        {
+            const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(samples + i));
+            _mm256_store_si256(reinterpret_cast<__m256i *>(clampedSamples + i),
+                               _mm256_min_epi16(_mm256_max_epi16(v, lower), upper));
+        }
+        samples  = clampedSamples;
+        minValue = minValue < 0 ? 0 : minValue;
+        maxValue = maxValue > MAX_SAMPLE_VALUE ? MAX_SAMPLE_VALUE : maxValue;
+    }
+
+    const Histograms histograms(samples, nrSamples, minValue, maxValue);
+    const auto shift = _mm_cvtsi32_si128(int(vca::getEntropyTableShift(nrSamples)));
+
+    // The table values of 4 bins are gathered at once
+    const auto table  = getEntropyTable();
+    const auto endBin = histograms.firstBin + histograms.nrBins;
+    auto sum          = _mm256_setzero_pd();
+    for (auto bin = histograms.firstBin; bin < endBin; bin += 4)
+    {
+        auto counts = _mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(&histograms.counts[0][bin]));
+        for (unsigned h = 1; h < vca::NR_ENTROPY_HISTOGRAMS; h++)
+            counts = _mm_add_epi16(counts,
+                                   _mm_loadl_epi64(reinterpret_cast<const __m128i *>(
+                                       &histograms.counts[h][bin])));
+        const auto index = _mm_sll_epi32(_mm_cvtepu16_epi32(counts), shift);
+        sum              = _mm256_add_pd(sum, _mm256_i32gather_pd(table, index, 8));
+    }
+
+    auto sum128 = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    sum128      = _mm_add_sd(sum128, _mm_unpackhi_pd(sum128, sum128));
+    return _mm_cvtsd_f64(sum128);
+}
+
+} // namespace
+
+#if (BIT_DEPTH == 8)
+double vca_entropy_8bit_avx2(const int16_t *src, unsigned blockSize)
+#elif (BIT_DEPTH == 10)
+double vca_entropy_10bit_avx2(const int16_t *src, unsigned blockSize)
+#elif (BIT_DEPTH == 12)
+double vca_entropy_12bit_avx2(const int16_t *src, unsigned blockSize)
+#endif
+{
+    return calculateEntropy(src, blockSize * blockSize);
+}
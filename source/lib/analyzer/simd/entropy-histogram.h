@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+
+namespace vca {
+
+constexpr unsigned ENTROPY_MAX_SAMPLES = 32 * 32;
+
+// Number of interleaved histograms. Counting consecutive equal samples into different
+// histograms avoids stalling on the increment of the same memory location.
+constexpr unsigned NR_ENTROPY_HISTOGRAMS = 4;
+
+// -p*log2(p) for p = count / ENTROPY_MAX_SAMPLES. All block sizes have a power of two number of
+// samples so for n samples the probability count / n is looked up at
+// count << getEntropyTableShift(n).
+// There is no global instance. The kernels fill the table on their first call, so that no code
+// built for a SIMD extension runs at program start, before the CPU was checked.
+struct EntropyTable
+{
+    EntropyTable()
+    {
+        this->values[0] = 0.0;
+        for (unsigned count = 1; count <= ENTROPY_MAX_SAMPLES; count++)
+        {
+            const auto probability = double(count) / ENTROPY_MAX_SAMPLES;
+            this->values[count]    = -probability * std::log2(probability);
+        }
+    }
+
+    double values[ENTROPY_MAX_SAMPLES + 1];
+};
+
+inline unsigned getEntropyTableShift(unsigned nrSamples)
+{
+    unsigned shift = 0;
+    while ((nrSamples << shift) < ENTROPY_MAX_SAMPLES)
+        shift++;
+    return shift;
+}
+
+// Histograms of samples in the range [minValue, maxValue]. Only the bins in this range are
+// cleared. The range is rounded up to a multiple of 4 bins so that the kernels can sum up the
+// table values of 4 bins at a time.
+template<unsigned BitDepth>
+struct EntropyHistograms
+{
+    static constexpr int MAX_SAMPLE_VALUE = (1 << BitDepth) - 1;
+
+    EntropyHistograms(const int16_t *samples, unsigned nrSamples, int minValue, int maxValue)
+        : firstBin(unsigned(minValue))
+        , nrBins(unsigned(maxValue - minValue + 4) & ~3u)
+    {
+        for (unsigned h = 0; h < NR_ENTROPY_HISTOGRAMS; h++)
+            std::memset(&this->counts[h][this->firstBin], 0, this->nrBins * sizeof(uint16_t));
+
+        for (unsigned i = 0; i < nrSamples; i += NR_ENTROPY_HISTOGRAMS)
+        {
+            this->counts[0][samples[i]]++;
+            this->counts[1][samples[i + 1]]++;
+            this->counts[2][samples[i + 2]]++;
+            this->counts[3][samples[i + 3]]++;
+        }
+    }
+
+    unsigned firstBin{};
+    unsigned nrBins{};
+    uint16_t counts[NR_ENTROPY_HISTOGRAMS][MAX_SAMPLE_VALUE + 4];
+};
+
+} // namespace vca
@@ -0,0 +1,111 @@
+/*****************************************************************************
+ * Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Amritha Premkumar <amritha.premkumar@ieee.org>
+ *          Prajit T Rajendran <prajit.rajendran@ieee.org>
+ *          Vignesh V Menon <vignesh.menon@hhi.fraunhofer.de>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include "entropy-histogram.h"
+#include "entropy.h"
+
+#include <arm_neon.h>
+
+#ifndef BIT_DEPTH
+#error "BIT_DEPTH must be specified"
+#endif
+
+namespace {
+
+using Histograms = vca::EntropyHistograms<BIT_DEPTH>;
+
+constexpr int MAX_SAMPLE_VALUE = Histograms::MAX_SAMPLE_VALUE;
+
+const double *getEntropyTable()
+{
+    static const vca::EntropyTable table;
+    return table.values;
+}
+
+// The number of samples must be a power of two and at least 16.
+double calculateEntropy(const int16_t *samples, const unsigned nrSamples)
+{
+    auto minVec = vld1q_s16(samples);
+    auto maxVec = minVec;
+    for (unsigned i = 8; i < nrSamples; i += 8)
+    {
+        const auto v = vld1q_s16(samples + i);
+        minVec       = vminq_s16(minVec, v);
+        maxVec       = vmaxq_s16(maxVec, v);
+    }
+    int minValue = vminvq_s16(minVec);
+    int maxValue = vmaxvq_s16(maxVec);
+
+    // Samples outside of the range of the bit depth are clamped so that they fit the histogram
+    alignas(16) int16_t clampedSamples[vca::ENTROPY_MAX_SAMPLES];
+    if (minValue < 0 || maxValue > MAX_SAMPLE_VALUE)
+    {
+        const auto lower = vdupq_n_s16(0);
+        const auto upper = vdupq_n_s16(MAX_SAMPLE_VALUE);
+        for (unsigned i = 0; i < nrSamples; i += 8)
+        {
+            const auto v = vld1q_s16(samples + i);
+            vst1q_s16(clampedSamples + i, vminq_s16(vmaxq_s16(v, lower), upper));
+        }
+        samples  = clampedSamples;
+        minValue = minValue < 0 ? 0 : minValue;
+        maxValue = maxValue > MAX_SAMPLE_VALUE ? MAX_SAMPLE_VALUE : maxValue;
+    }
+
+    const Histograms histograms(samples, nrSamples, minValue, maxValue);
+    const auto shift = vdupq_n_s32(int(vca::getEntropyTableShift(nrSamples)));
+
+    // The table values of 4 consecutive bins are summed up in the same order as in the AVX2
+    // version so that both give identical results.
+    const auto table  = getEntropyTable();
+    const auto endBin = histograms.firstBin + histograms.nrBins;
+    auto sumLow       = vdupq_n_f64(0.0);
+    auto sumHigh      = vdupq_n_f64(0.0);
+    for (auto bin = histograms.firstBin; bin < endBin; bin += 4)
+    {
+        auto counts = vld1_u16(&histograms.counts[0][bin]);
+        for (unsigned h = 1; h < vca::NR_ENTROPY_HISTOGRAMS; h++)
+            counts = vadd_u16(counts, vld1_u16(&histograms.counts[h][bin]));
+        const auto index = vshlq_u32(vmovl_u16(counts), shift);
+
+        sumLow  = vaddq_f64(sumLow,
+                            vcombine_f64(vld1_f64(&table[vgetq_lane_u32(index, 0)]),
+                                         vld1_f64(&table[vgetq_lane_u32(index, 1)])));
+        sumHigh = vaddq_f64(sumHigh,
+                            vcombine_f64(vld1_f64(&table[vgetq_lane_u32(index, 2)]),
+                                         vld1_f64(&table[vgetq_lane_u32(index, 3)])));
+    }
+
+    return vaddvq_f64(vaddq_f64(sumLow, sumHigh));
+}
+
+} // namespace
+
+#if (BIT_DEPTH == 8)
+double vca_entropy_8bit_neon(const int16_t *src, unsigned blockSize)
+#elif (BIT_DEPTH == 10)
+double vca_entropy_10bit_neon(const int16_t *src, unsigned blockSize)
+#elif (BIT_DEPTH == 12)
+double vca_entropy_12bit_neon(const int16_t *src, unsigned blockSize)
+#endif
+{
+    return calculateEntropy(src, blockSize * blockSize);
+}
@@ -23,4 +23,11 @@
 
 #include <stdint.h>
 
-double entropy_avx2(const std::vector<int16_t> &block);
+// Entropy of the samples of a block. A flat histogram of the sample values is counted and the
+// entropy is summed up from a -p*log2(p) lookup table (using AVX2 gathers on x86).
+double vca_entropy_8bit_avx2(const int16_t *src, unsigned blockSize);
+double vca_entropy_10bit_avx2(const int16_t *src, unsigned blockSize);
+double vca_entropy_12bit_avx2(const int16_t *src, unsigned blockSize);
+double vca_entropy_8bit_neon(const int16_t *src, unsigned blockSize);
+double vca_entropy_10bit_neon(const int16_t *src, unsigned blockSize);
+double vca_entropy_12bit_neon(const int16_t *src, unsigned blockSize);
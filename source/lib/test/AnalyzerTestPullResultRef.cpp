@@ -0,0 +1,155 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/Analyzer.h>
+#include <analyzer/common/common.h>
+#include <test/common/functions.h>
+
+#include <vector>
+
+namespace {
+
+constexpr unsigned NR_FRAMES = 4;
+
+vca_param getParam(const test::TestFrame &frame, unsigned blockSize)
+{
+    vca_param param;
+    param.blockSize      = blockSize;
+    param.frameInfo      = frame.frame.info;
+    param.nrFrameThreads = 2;
+    return param;
+}
+
+template<typename T>
+std::vector<T> toVector(const T *values, size_t size)
+{
+    return std::vector<T>(values, values + size);
+}
+
+} // namespace
+
+using BlockSize = unsigned;
+
+class AnalyzerTestPullResultRefFixture : public testing::TestWithParam<BlockSize>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<BlockSize> &info)
+    {
+        return "BlockSize" + std::to_string(info.param);
+    }
+};
+
+TEST_P(AnalyzerTestPullResultRefFixture, TestThatLentResultsMatchCopiedResults)
+{
+    const auto blockSize = GetParam();
+
+    std::vector<test::TestFrame> frames;
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+        frames.emplace_back(test::FRAME_WIDTH, test::FRAME_HEIGHT, 8);
+
+    std::vector<test::TestResult> copiedResults;
+    {
+        vca::Analyzer analyzer(getParam(frames.front(), blockSize));
+        for (auto &frame : frames)
+        {
+            EXPECT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+            copiedResults.emplace_back(frame.frame.info, blockSize);
+            EXPECT_EQ(analyzer.pullResult(&copiedResults.back().result), VCA_OK);
+        }
+    }
+
+    vca::Analyzer analyzer(getParam(frames.front(), blockSize));
+
+    // Hold on to all results so that none of the buffers can be reused while lent out
+    std::vector<const vca_frame_results *> lentResults;
+    for (auto &frame : frames)
+    {
+        EXPECT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+        const vca_frame_results *result{};
+        EXPECT_EQ(analyzer.pullResultRef(&result), VCA_OK);
+        ASSERT_NE(result, nullptr);
+        lentResults.push_back(result);
+    }
+
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+    {
+        const auto &expected = copiedResults[i];
+        const auto actual    = lentResults[i];
+        const auto nrBlocks  = expected.nrBlocks;
+        EXPECT_EQ(expected.result.jobID, actual->jobID);
+        EXPECT_EQ(expected.result.averageEnergy, actual->averageEnergy);
+        EXPECT_EQ(expected.result.energyDiff, actual->energyDiff);
+        EXPECT_EQ(expected.result.averageEntropy, actual->averageEntropy);
+        EXPECT_EQ(expected.result.averageEdgeDensity, actual->averageEdgeDensity);
+        EXPECT_EQ(expected.energy, toVector(actual->energyPerBlock, nrBlocks));
+        EXPECT_EQ(expected.entropy, toVector(actual->entropyPerBlock, nrBlocks));
+        EXPECT_EQ(expected.edgeDensity, toVector(actual->edgeDensityPerBlock, nrBlocks));
+        if (i == 0)
+            EXPECT_EQ(actual->energyDiffPerBlock, nullptr);
+        else
+            EXPECT_EQ(expected.energyDiff, toVector(actual->energyDiffPerBlock, nrBlocks));
+    }
+
+    for (const auto result : lentResults)
+        EXPECT_EQ(analyzer.releaseResult(result), VCA_OK);
+    for (const auto result : lentResults)
+        EXPECT_EQ(analyzer.releaseResult(result), VCA_ERROR);
+
+    vca_frame_results unknownResult;
+    EXPECT_EQ(analyzer.releaseResult(&unknownResult), VCA_ERROR);
+}
+
+TEST_P(AnalyzerTestPullResultRefFixture, TestThatReleasingTwiceFailsAndKeepsThePreviousResult)
+{
+    const auto blockSize = GetParam();
+
+    std::vector<test::TestFrame> frames;
+    for (unsigned i = 0; i < 2; i++)
+        frames.emplace_back(test::FRAME_WIDTH, test::FRAME_HEIGHT, 8);
+
+    std::vector<test::TestResult> copiedResults;
+    {
+        vca::Analyzer analyzer(getParam(frames.front(), blockSize));
+        for (auto &frame : frames)
+        {
+            EXPECT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+            copiedResults.emplace_back(frame.frame.info, blockSize);
+            EXPECT_EQ(analyzer.pullResult(&copiedResults.back().result), VCA_OK);
+        }
+    }
+
+    vca::Analyzer analyzer(getParam(frames.front(), blockSize));
+    EXPECT_EQ(analyzer.pushFrame(&frames[0].frame), VCA_OK);
+    const vca_frame_results *result{};
+    EXPECT_EQ(analyzer.pullResultRef(&result), VCA_OK);
+    EXPECT_EQ(analyzer.releaseResult(result), VCA_OK);
+    EXPECT_EQ(analyzer.releaseResult(result), VCA_ERROR);
+
+    // The analyzer still holds the first frame for the SAD of the second one
+    EXPECT_EQ(analyzer.pushFrame(&frames[1].frame), VCA_OK);
+    EXPECT_EQ(analyzer.pullResultRef(&result), VCA_OK);
+    EXPECT_EQ(result->energyDiff, copiedResults[1].result.energyDiff);
+    EXPECT_EQ(analyzer.releaseResult(result), VCA_OK);
+}
+
+INSTANTIATE_TEST_SUITE_P(AnalyzerTest,
+                         AnalyzerTestPullResultRefFixture,
+                         testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                         &AnalyzerTestPullResultRefFixture::generateName);
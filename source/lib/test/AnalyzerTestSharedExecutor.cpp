@@ -0,0 +1,139 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/Analyzer.h>
+#include <analyzer/Executor.h>
+#include <analyzer/common/common.h>
+#include <test/common/functions.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr unsigned BLOCK_SIZE   = 16;
+constexpr unsigned NR_FRAMES    = 6;
+constexpr unsigned NR_ANALYZERS = 3;
+
+// Push all frames and pull the results while the frames are analyzed
+std::vector<test::TestResult> analyzeFrames(std::vector<test::TestFrame> &frames,
+                                            vca::Executor *executor)
+{
+    vca_param param;
+    param.blockSize      = BLOCK_SIZE;
+    param.frameInfo      = frames.front().frame.info;
+    param.nrFrameThreads = 2;
+    param.executor       = executor;
+
+    vca::Analyzer analyzer(param);
+    std::vector<test::TestResult> results;
+    for (const auto &frame : frames)
+        results.emplace_back(frame.frame.info, BLOCK_SIZE);
+
+    std::thread puller([&]() {
+        for (auto &result : results)
+            EXPECT_EQ(analyzer.pullResult(&result.result), VCA_OK);
+    });
+    for (auto &frame : frames)
+        EXPECT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+    puller.join();
+
+    return results;
+}
+
+} // namespace
+
+using NrExecutorThreads = unsigned;
+
+class AnalyzerTestSharedExecutorFixture : public testing::TestWithParam<NrExecutorThreads>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<NrExecutorThreads> &info)
+    {
+        return "Threads" + std::to_string(info.param);
+    }
+};
+
+TEST_P(AnalyzerTestSharedExecutorFixture, TestThatAnalyzersSharingAnExecutorProduceIdenticalResults)
+{
+    std::vector<std::vector<test::TestFrame>> frames(NR_ANALYZERS);
+    std::vector<std::vector<test::TestResult>> reference;
+    for (auto &analyzerFrames : frames)
+    {
+        for (unsigned i = 0; i < NR_FRAMES; i++)
+            analyzerFrames.emplace_back(test::FRAME_WIDTH, test::FRAME_HEIGHT, 8);
+        reference.push_back(analyzeFrames(analyzerFrames, nullptr));
+    }
+
+    vca::Executor executor(GetParam());
+    std::vector<std::vector<test::TestResult>> shared(NR_ANALYZERS);
+    std::vector<std::thread> streams;
+    for (unsigned i = 0; i < NR_ANALYZERS; i++)
+        streams.emplace_back([&, i]() { shared[i] = analyzeFrames(frames[i], &executor); });
+    for (auto &stream : streams)
+        stream.join();
+
+    for (unsigned i = 0; i < NR_ANALYZERS; i++)
+    {
+        for (unsigned frame = 0; frame < NR_FRAMES; frame++)
+        {
+            const auto &expected = reference[i][frame];
+            const auto &actual   = shared[i][frame];
+            EXPECT_EQ(expected.result.poc, actual.result.poc);
+            EXPECT_EQ(expected.result.jobID, actual.result.jobID);
+            EXPECT_EQ(expected.result.averageEnergy, actual.result.averageEnergy);
+            EXPECT_EQ(expected.result.energyDiff, actual.result.energyDiff);
+            EXPECT_EQ(expected.result.averageEntropy, actual.result.averageEntropy);
+            EXPECT_EQ(expected.energy, actual.energy);
+            EXPECT_EQ(expected.entropy, actual.entropy);
+        }
+    }
+}
+
+TEST_P(AnalyzerTestSharedExecutorFixture, TestThatAnAnalyzerCanBeClosedWithFramesPending)
+{
+    std::vector<test::TestFrame> frames;
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+        frames.emplace_back(test::FRAME_WIDTH, test::FRAME_HEIGHT, 8);
+
+    vca::Executor executor(GetParam());
+    for (unsigned run = 0; run < 2; run++)
+    {
+        vca_param param;
+        param.blockSize = BLOCK_SIZE;
+        param.frameInfo = frames.front().frame.info;
+        param.executor  = &executor;
+
+        vca::Analyzer analyzer(param);
+        for (auto &frame : frames)
+            EXPECT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+    }
+
+    // The executor still works for new analyzers
+    const auto results = analyzeFrames(frames, &executor);
+    EXPECT_EQ(results.back().result.jobID, NR_FRAMES - 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(AnalyzerTest,
+                         AnalyzerTestSharedExecutorFixture,
+                         testing::ValuesIn({NrExecutorThreads(1u),
+                                            NrExecutorThreads(2u),
+                                            NrExecutorThreads(4u)}),
+                         &AnalyzerTestSharedExecutorFixture::generateName);
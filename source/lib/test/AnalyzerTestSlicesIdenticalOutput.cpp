@@ -0,0 +1,108 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/Analyzer.h>
+#include <analyzer/common/common.h>
+#include <test/common/functions.h>
+
+#include <vector>
+
+namespace {
+
+constexpr unsigned NR_FRAMES = 3;
+
+std::vector<test::TestResult> analyzeFrames(std::vector<test::TestFrame> &frames,
+                                            unsigned blockSize,
+                                            unsigned nrSliceThreads)
+{
+    vca_param param;
+    param.blockSize          = blockSize;
+    param.frameInfo          = frames.front().frame.info;
+    param.nrFrameThreads     = 4;
+    param.nrSliceThreads     = nrSliceThreads;
+    param.enableEnergyChroma = true;
+
+    vca::Analyzer analyzer(param);
+    for (auto &frame : frames)
+        EXPECT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+
+    std::vector<test::TestResult> results;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        results.emplace_back(frames[i].frame.info, blockSize);
+        EXPECT_EQ(analyzer.pullResult(&results.back().result), VCA_OK);
+    }
+    return results;
+}
+
+} // namespace
+
+using BlockSize = unsigned;
+using BitDepth  = unsigned;
+using TestCase  = std::tuple<BlockSize, BitDepth>;
+
+class AnalyzerTestSlicesIdenticalOutputFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize = std::get<0>(info.param);
+        const auto bitDepth  = std::get<1>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + "_BitDepth" + std::to_string(bitDepth);
+    }
+};
+
+TEST_P(AnalyzerTestSlicesIdenticalOutputFixture, TestThatSlicedAnalysisProducesIdenticalResults)
+{
+    const auto blockSize = std::get<0>(GetParam());
+    const auto bitDepth  = std::get<1>(GetParam());
+
+    std::vector<test::TestFrame> frames;
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+        frames.emplace_back(test::FRAME_WIDTH, test::FRAME_HEIGHT, bitDepth);
+
+    const auto reference = analyzeFrames(frames, blockSize, 1);
+    const auto sliced    = analyzeFrames(frames, blockSize, 5);
+
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+    {
+        const auto &expected = reference[i];
+        const auto &actual   = sliced[i];
+        EXPECT_EQ(expected.result.poc, actual.result.poc);
+        EXPECT_EQ(expected.result.averageEnergy, actual.result.averageEnergy);
+        EXPECT_EQ(expected.result.energyDiff, actual.result.energyDiff);
+        EXPECT_EQ(expected.result.averageU, actual.result.averageU);
+        EXPECT_EQ(expected.result.averageEntropy, actual.result.averageEntropy);
+        EXPECT_EQ(expected.result.entropyV, actual.result.entropyV);
+        EXPECT_EQ(expected.result.averageEdgeDensity, actual.result.averageEdgeDensity);
+        EXPECT_EQ(expected.energy, actual.energy);
+        EXPECT_EQ(expected.energyU, actual.energyU);
+        EXPECT_EQ(expected.entropy, actual.entropy);
+        EXPECT_EQ(expected.entropyV, actual.entropyV);
+        EXPECT_EQ(expected.edgeDensity, actual.edgeDensity);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AnalyzerTest,
+    AnalyzerTestSlicesIdenticalOutputFixture,
+    testing::Combine(testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                     testing::ValuesIn({BitDepth(8u), BitDepth(10u)})),
+    &AnalyzerTestSlicesIdenticalOutputFixture::generateName);
@@ -0,0 +1,137 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/Analyzer.h>
+#include <analyzer/common/common.h>
+#include <test/common/functions.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr unsigned FRAME_WIDTH  = 360;
+constexpr unsigned FRAME_HEIGHT = 202;
+constexpr unsigned NR_FRAMES    = 12;
+
+vca_param getParam(const test::TestFrame &frame, unsigned jobQueueSize, unsigned resultQueueSize)
+{
+    vca_param param;
+    param.blockSize       = 16;
+    param.frameInfo       = frame.frame.info;
+    param.nrFrameThreads  = 2;
+    param.jobQueueSize    = jobQueueSize;
+    param.resultQueueSize = resultQueueSize;
+    return param;
+}
+
+} // namespace
+
+using JobQueueSize    = unsigned;
+using ResultQueueSize = unsigned;
+using TestCase        = std::tuple<JobQueueSize, ResultQueueSize>;
+
+class AnalyzerTestTryPushFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        return "JobQueueSize" + std::to_string(std::get<0>(info.param)) + "_ResultQueueSize"
+               + std::to_string(std::get<1>(info.param));
+    }
+};
+
+TEST_P(AnalyzerTestTryPushFixture, TestThatTryPushAnalyzesAllFramesInOrder)
+{
+    const auto jobQueueSize    = std::get<0>(GetParam());
+    const auto resultQueueSize = std::get<1>(GetParam());
+
+    std::vector<test::TestFrame> frames;
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+        frames.emplace_back(FRAME_WIDTH, FRAME_HEIGHT, 8);
+
+    std::vector<vca_frame_results> expectedResults(NR_FRAMES);
+    {
+        vca::Analyzer analyzer(getParam(frames.front(), 0, 0));
+        for (auto &frame : frames)
+            EXPECT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+        for (auto &result : expectedResults)
+            EXPECT_EQ(analyzer.pullResult(&result), VCA_OK);
+    }
+
+    vca::Analyzer analyzer(getParam(frames.front(), jobQueueSize, resultQueueSize));
+
+    // Pull results while the analyzer is busy, like an ingest loop that does other work
+    std::vector<vca_frame_results> results;
+    auto pullResult = [&analyzer, &results]() {
+        results.emplace_back();
+        EXPECT_EQ(analyzer.pullResult(&results.back()), VCA_OK);
+    };
+    for (auto &frame : frames)
+    {
+        while (true)
+        {
+            const auto pushResult = analyzer.tryPushFrame(&frame.frame);
+            if (pushResult == VCA_OK)
+                break;
+            ASSERT_EQ(pushResult, VCA_BUSY);
+            if (analyzer.resultAvailable())
+                pullResult();
+            else
+                std::this_thread::yield();
+        }
+    }
+    while (results.size() < NR_FRAMES)
+        pullResult();
+
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+    {
+        EXPECT_EQ(results[i].jobID, i);
+        EXPECT_EQ(results[i].averageEnergy, expectedResults[i].averageEnergy);
+        EXPECT_EQ(results[i].energyDiff, expectedResults[i].energyDiff);
+        EXPECT_EQ(results[i].averageEntropy, expectedResults[i].averageEntropy);
+        EXPECT_EQ(results[i].averageEdgeDensity, expectedResults[i].averageEdgeDensity);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AnalyzerTest,
+                         AnalyzerTestTryPushFixture,
+                         testing::Combine(testing::ValuesIn({JobQueueSize(0), JobQueueSize(1)}),
+                                          testing::ValuesIn({ResultQueueSize(0),
+                                                             ResultQueueSize(1)})),
+                         &AnalyzerTestTryPushFixture::generateName);
+
+TEST(AnalyzerTest, TestThatAllFramesCanBePushedBeforePullingWithTheDefaultQueueSizes)
+{
+    // More frames than fit into the ring buffer of the result queue
+    constexpr unsigned NR_PUSHED_FRAMES = 1100;
+
+    test::TestFrame frame(64, 64, 8);
+    vca::Analyzer analyzer(getParam(frame, 0, 0));
+    for (unsigned i = 0; i < NR_PUSHED_FRAMES; i++)
+        ASSERT_EQ(analyzer.pushFrame(&frame.frame), VCA_OK);
+
+    for (unsigned i = 0; i < NR_PUSHED_FRAMES; i++)
+    {
+        vca_frame_results result;
+        ASSERT_EQ(analyzer.pullResult(&result), VCA_OK);
+        EXPECT_EQ(result.jobID, i);
+    }
+}
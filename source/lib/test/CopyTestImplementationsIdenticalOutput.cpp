@@ -0,0 +1,152 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/common/common.h>
+#include <analyzer/simd/copy.h>
+#include <analyzer/simd/cpu.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr auto MAX_BLOCKSIZE_SAMPLES = 32 * 32;
+
+template<typename Sample>
+void copyBlockReference(const Sample *src,
+                        intptr_t srcStride,
+                        unsigned blockSize,
+                        unsigned paddingRight,
+                        unsigned paddingBottom,
+                        int16_t *dst)
+{
+    for (unsigned y = 0; y < blockSize; y++)
+    {
+        const auto srcY = std::min(y, blockSize - paddingBottom - 1);
+        for (unsigned x = 0; x < blockSize; x++)
+        {
+            const auto srcX        = std::min(x, blockSize - paddingRight - 1);
+            dst[y * blockSize + x] = int16_t(src[srcY * srcStride + srcX]);
+        }
+    }
+}
+
+// The valid area of the block is placed at the very end of the returned samples so that reading
+// past the last valid sample would leave the allocation.
+template<typename Sample>
+std::vector<Sample> createSource(intptr_t stride,
+                                 unsigned width,
+                                 unsigned height,
+                                 unsigned bitDepth)
+{
+    std::default_random_engine randomEngine(42);
+    std::uniform_int_distribution<int> distribution(0, (1 << bitDepth) - 1);
+
+    std::vector<Sample> samples((height - 1) * stride + width);
+    for (auto &sample : samples)
+        sample = Sample(distribution(randomEngine));
+    return samples;
+}
+
+} // namespace
+
+using BlockSize = unsigned;
+using BitDepth  = unsigned;
+using TestCase  = std::tuple<BlockSize, BitDepth>;
+
+class CopyTestImplementationsIdenticalOutputFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize = std::get<0>(info.param);
+        const auto bitDepth  = std::get<1>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + "_BitDepth" + std::to_string(bitDepth);
+    }
+};
+
+TEST_P(CopyTestImplementationsIdenticalOutputFixture,
+       TestThatAllImplementationsProduceIdenticalResults)
+{
+    const auto blockSize = std::get<0>(GetParam());
+    const auto bitDepth  = std::get<1>(GetParam());
+
+#if VCA_ARCH_X86
+    for (unsigned padding = 0; padding < blockSize; padding++)
+    {
+        const auto paddingRight  = padding;
+        const auto paddingBottom = (blockSize - 1 - padding) / 2;
+        const auto width         = blockSize - paddingRight;
+        const auto height        = blockSize - paddingBottom;
+        const auto stride        = intptr_t(width + 5);
+
+        const auto src8  = createSource<uint8_t>(stride, width, height, 8);
+        const auto src16 = createSource<int16_t>(stride, width, height, bitDepth);
+
+        ALIGN_VAR_32(int16_t, expected[MAX_BLOCKSIZE_SAMPLES]);
+        if (bitDepth == 8)
+            copyBlockReference(src8.data(),
+                               stride,
+                               blockSize,
+                               paddingRight,
+                               paddingBottom,
+                               expected);
+        else
+            copyBlockReference(src16.data(),
+                               stride,
+                               blockSize,
+                               paddingRight,
+                               paddingBottom,
+                               expected);
+
+        for (const auto cpuSimd : {CpuSimd::SSE2, CpuSimd::AVX2})
+        {
+            if (!vca::isSimdSupported(cpuSimd))
+            {
+                std::cout << "Skipping testing of " << vca::CpuSimdMapper.getName(cpuSimd)
+                          << " because it is not supported on this platform.";
+                continue;
+            }
+
+            ALIGN_VAR_32(int16_t, buffer[MAX_BLOCKSIZE_SAMPLES]);
+            const auto copyBlock8  = (cpuSimd == CpuSimd::AVX2) ? vca_copy_block_8bit_avx2
+                                                                : vca_copy_block_8bit_sse2;
+            const auto copyBlock16 = (cpuSimd == CpuSimd::AVX2) ? vca_copy_block_avx2
+                                                                : vca_copy_block_sse2;
+            if (bitDepth == 8)
+                copyBlock8(src8.data(), stride, blockSize, paddingRight, paddingBottom, buffer);
+            else
+                copyBlock16(src16.data(), stride, blockSize, paddingRight, paddingBottom, buffer);
+
+            for (unsigned i = 0; i < blockSize * blockSize; i++)
+                EXPECT_EQ(expected[i], buffer[i])
+                    << "SIMD " << vca::CpuSimdMapper.getName(cpuSimd) << " padding right "
+                    << paddingRight << " bottom " << paddingBottom << " sample " << i;
+        }
+    }
+#endif
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CopyTest,
+    CopyTestImplementationsIdenticalOutputFixture,
+    testing::Combine(testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                     testing::ValuesIn({BitDepth(8u), BitDepth(10u), BitDepth(12u)})),
+    &CopyTestImplementationsIdenticalOutputFixture::generateName);
@@ -146,8 +146,13 @@ INSTANTIATE_TEST_SUITE_P(
     testing::Combine(
         testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
         testing::ValuesIn({BitDepth(8u), BitDepth(10u), BitDepth(12u)}),
-        testing::ValuesIn(
-            {CpuSimd::None, CpuSimd::SSE2, CpuSimd::SSSE3, CpuSimd::SSE4, CpuSimd::AVX2})),
+        testing::ValuesIn({CpuSimd::None,
+                           CpuSimd::SSE2,
+                           CpuSimd::SSSE3,
+                           CpuSimd::SSE4,
+                           CpuSimd::AVX2,
+                           CpuSimd::AVX512,
+                           CpuSimd::NEON})),
     &DCTTestForwardBackwardsFixture::generateName);
 
 // This code was used to get the results table above.
@@ -0,0 +1,142 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/DCTTransform.h>
+#include <analyzer/Downscale.h>
+#include <analyzer/common/common.h>
+#include <analyzer/simd/cpu.h>
+#include <test/common/functions.h>
+
+#include <vector>
+
+namespace {
+
+constexpr auto MAX_BLOCKSIZE_SAMPLES = 32 * 32;
+
+// Odd plane size and block positions so that the rows of most blocks are not aligned
+constexpr unsigned PLANE_WIDTH  = 77;
+constexpr unsigned PLANE_HEIGHT = 41;
+
+struct BlockPosition
+{
+    unsigned x{};
+    unsigned y{};
+};
+
+constexpr BlockPosition BLOCK_POSITIONS[] = {{0, 0}, {4, 1}, {9, 3}, {PLANE_WIDTH - 32, 5}};
+
+void copyBlockToBuffer(const uint8_t *src,
+                       unsigned srcStrideBytes,
+                       unsigned blockSize,
+                       unsigned bitDepth,
+                       int16_t *buffer)
+{
+    for (unsigned y = 0; y < blockSize; y++, src += srcStrideBytes)
+        for (unsigned x = 0; x < blockSize; x++)
+            *(buffer++) = (bitDepth > 8) ? reinterpret_cast<const int16_t *>(src)[x]
+                                         : int16_t(src[x]);
+}
+
+} // namespace
+
+using BlockSize = unsigned;
+using BitDepth  = unsigned;
+using TestCase  = std::tuple<BlockSize, BitDepth>;
+
+class DCTTestFromPlaneIdenticalOutputFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize = std::get<0>(info.param);
+        const auto bitDepth  = std::get<1>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + "_BitDepth" + std::to_string(bitDepth);
+    }
+};
+
+TEST_P(DCTTestFromPlaneIdenticalOutputFixture, TestThatReadingFromThePlaneProducesIdenticalResults)
+{
+    const auto blockSize     = std::get<0>(GetParam());
+    const auto bitDepth      = std::get<1>(GetParam());
+    const auto bytesPerPixel = (bitDepth > 8) ? 2u : 1u;
+    const auto nrSamples     = blockSize * blockSize;
+    const auto nrDownscaled  = nrSamples / 4;
+
+    test::TestFrame frame(PLANE_WIDTH, PLANE_HEIGHT, bitDepth);
+    const auto plane          = frame.frame.planes[0];
+    const auto srcStrideBytes = unsigned(frame.frame.stride[0]);
+
+    for (const auto position : BLOCK_POSITIONS)
+    {
+        const auto src = plane + position.y * srcStrideBytes + position.x * bytesPerPixel;
+
+        ALIGN_VAR_32(int16_t, pixelBuffer[MAX_BLOCKSIZE_SAMPLES]);
+        copyBlockToBuffer(src, srcStrideBytes, blockSize, bitDepth, pixelBuffer);
+
+        for (const auto cpuSimd : {CpuSimd::None,
+                                   CpuSimd::SSE2,
+                                   CpuSimd::SSSE3,
+                                   CpuSimd::SSE4,
+                                   CpuSimd::AVX2,
+                                   CpuSimd::AVX512,
+                                   CpuSimd::NEON})
+        {
+            if (!vca::isSimdSupported(cpuSimd))
+            {
+                std::cout << "Skipping testing of " << vca::CpuSimdMapper.getName(cpuSimd)
+                          << " because it is not supported on this platform.";
+                continue;
+            }
+
+            std::vector<int16_t> expected(nrSamples);
+            std::vector<int16_t> coeffs(nrSamples);
+            vca::performDCT(blockSize, bitDepth, pixelBuffer, expected.data(), cpuSimd, false);
+            vca::performDCTFromPlane(blockSize,
+                                     bitDepth,
+                                     src,
+                                     srcStrideBytes,
+                                     coeffs.data(),
+                                     cpuSimd);
+            EXPECT_EQ(expected, coeffs);
+
+            std::vector<int16_t> expectedDownscaled(nrDownscaled);
+            std::vector<int16_t> downscaled(nrDownscaled);
+            const auto expectedSum = vca::performDownscale(blockSize,
+                                                           pixelBuffer,
+                                                           expectedDownscaled.data(),
+                                                           cpuSimd);
+            const auto sum         = vca::performDownscaleFromPlane(blockSize,
+                                                                    bitDepth,
+                                                                    src,
+                                                                    srcStrideBytes,
+                                                                    downscaled.data(),
+                                                                    cpuSimd);
+            EXPECT_EQ(expectedSum, sum);
+            EXPECT_EQ(expectedDownscaled, downscaled);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DCTTest,
+    DCTTestFromPlaneIdenticalOutputFixture,
+    testing::Combine(testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                     testing::ValuesIn({BitDepth(8u), BitDepth(10u), BitDepth(12u)})),
+    &DCTTestFromPlaneIdenticalOutputFixture::generateName);
@@ -79,7 +79,12 @@ TEST_P(DCTTestImplementationsIdenticalOutputFixture,
                     CpuSimd::None,
                     enableLowpassDCT);
 
-    for (const auto cpuSimd : {CpuSimd::SSE2, CpuSimd::SSSE3, CpuSimd::SSE4, CpuSimd::AVX2})
+    for (const auto cpuSimd : {CpuSimd::SSE2,
+                               CpuSimd::SSSE3,
+                               CpuSimd::SSE4,
+                               CpuSimd::AVX2,
+                               CpuSimd::AVX512,
+                               CpuSimd::NEON})
     {
         if (!vca::isSimdSupported(cpuSimd))
         {
@@ -0,0 +1,85 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+
+#include <analyzer/Downscale.h>
+#include <analyzer/common/common.h>
+#include <analyzer/simd/cpu.h>
+#include <test/common/functions.h>
+
+#include <vector>
+
+namespace {
+
+constexpr auto MAX_BLOCKSIZE_SAMPLES = 32 * 32;
+
+} // namespace
+
+using BlockSize = unsigned;
+using BitDepth  = unsigned;
+using TestCase  = std::tuple<BlockSize, BitDepth>;
+
+class DownscaleTestImplementationsIdenticalOutputFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize = std::get<0>(info.param);
+        const auto bitDepth  = std::get<1>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + "_BitDepth" + std::to_string(bitDepth);
+    }
+};
+
+TEST_P(DownscaleTestImplementationsIdenticalOutputFixture,
+       TestThatAllImplementationsProduceIdenticalResults)
+{
+    const auto blockSize = std::get<0>(GetParam());
+    const auto bitDepth  = std::get<1>(GetParam());
+    const auto nrSamples = (blockSize / 2) * (blockSize / 2);
+
+    ALIGN_VAR_32(int16_t, pixelBuffer[MAX_BLOCKSIZE_SAMPLES]);
+    test::fillBlockWithRandomData(pixelBuffer, blockSize, bitDepth);
+
+    std::vector<int16_t> expected(nrSamples);
+    const auto expectedSum = vca::performDownscale(blockSize,
+                                                   pixelBuffer,
+                                                   expected.data(),
+                                                   CpuSimd::None);
+
+    for (const auto cpuSimd : {CpuSimd::SSE2, CpuSimd::AVX2, CpuSimd::AVX512})
+    {
+        if (!vca::isSimdSupported(cpuSimd))
+        {
+            std::cout << "Skipping testing of " << vca::CpuSimdMapper.getName(cpuSimd)
+                      << " because it is not supported on this platform.";
+            continue;
+        }
+
+        std::vector<int16_t> downscaled(nrSamples);
+        const auto sum = vca::performDownscale(blockSize, pixelBuffer, downscaled.data(), cpuSimd);
+        EXPECT_EQ(expectedSum, sum);
+        EXPECT_EQ(expected, downscaled);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DownscaleTest,
+    DownscaleTestImplementationsIdenticalOutputFixture,
+    testing::Combine(testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                     testing::ValuesIn({BitDepth(8u), BitDepth(10u), BitDepth(12u)})),
+    &DownscaleTestImplementationsIdenticalOutputFixture::generateName);
@@ -0,0 +1,119 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/EntropyCalculation.h>
+#include <analyzer/common/common.h>
+#include <analyzer/simd/cpu.h>
+#include <test/common/functions.h>
+
+#include <cstdlib>
+
+namespace {
+
+constexpr auto MAX_BLOCKSIZE_SAMPLES = 32 * 32;
+
+double edgeDensityReference(const int16_t *pixelBuffer, unsigned blockSize, unsigned bitDepth)
+{
+    const auto threshold = (1 << (bitDepth - 1)) - 1;
+
+    unsigned edgeCount = 0;
+    for (unsigned y = 0; y < blockSize; y++)
+    {
+        for (unsigned x = 0; x < blockSize; x++)
+        {
+            const auto i = y * blockSize + x;
+            if (x + 1 < blockSize && std::abs(pixelBuffer[i] - pixelBuffer[i + 1]) > threshold)
+                edgeCount++;
+            if (y + 1 < blockSize
+                && std::abs(pixelBuffer[i] - pixelBuffer[i + blockSize]) > threshold)
+                edgeCount++;
+        }
+    }
+    return static_cast<double>(edgeCount) / (2 * blockSize * (blockSize - 1));
+}
+
+} // namespace
+
+using BlockSize = unsigned;
+using BitDepth  = unsigned;
+using TestCase  = std::tuple<BlockSize, BitDepth>;
+
+class EdgeDensityTestImplementationsIdenticalOutputFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize = std::get<0>(info.param);
+        const auto bitDepth  = std::get<1>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + "_BitDepth" + std::to_string(bitDepth);
+    }
+};
+
+TEST_P(EdgeDensityTestImplementationsIdenticalOutputFixture,
+       TestThatAllImplementationsProduceIdenticalResults)
+{
+    const auto blockSize = std::get<0>(GetParam());
+    const auto bitDepth  = std::get<1>(GetParam());
+    const auto maxValue  = int16_t((1 << bitDepth) - 1);
+
+    ALIGN_VAR_32(int16_t, pixelBuffer[MAX_BLOCKSIZE_SAMPLES]);
+    ALIGN_VAR_32(int16_t, checkerboardPixelBuffer[MAX_BLOCKSIZE_SAMPLES]);
+
+    test::fillBlockWithRandomData(pixelBuffer, blockSize, bitDepth);
+
+    // Every pair of neighboring samples is an edge
+    for (unsigned y = 0; y < blockSize; y++)
+        for (unsigned x = 0; x < blockSize; x++)
+            checkerboardPixelBuffer[y * blockSize + x] = ((x + y) % 2) ? maxValue : 0;
+
+    for (const auto buffer : {pixelBuffer, checkerboardPixelBuffer})
+    {
+        const auto expected = edgeDensityReference(buffer, blockSize, bitDepth);
+
+        for (const auto cpuSimd : {CpuSimd::None,
+                                   CpuSimd::SSSE3,
+                                   CpuSimd::SSE4,
+                                   CpuSimd::AVX2,
+                                   CpuSimd::AVX512,
+                                   CpuSimd::NEON})
+        {
+            if (!vca::isSimdSupported(cpuSimd))
+            {
+                std::cout << "Skipping testing of " << vca::CpuSimdMapper.getName(cpuSimd)
+                          << " because it is not supported on this platform.";
+                continue;
+            }
+
+            const auto edgeDensity = vca::performEdgeDensity(blockSize,
+                                                             bitDepth,
+                                                             buffer,
+                                                             cpuSimd,
+                                                             false);
+            EXPECT_EQ(expected, edgeDensity) << "SIMD " << vca::CpuSimdMapper.getName(cpuSimd);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    EdgeDensityTest,
+    EdgeDensityTestImplementationsIdenticalOutputFixture,
+    testing::Combine(testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                     testing::ValuesIn({BitDepth(8u), BitDepth(10u), BitDepth(12u)})),
+    &EdgeDensityTestImplementationsIdenticalOutputFixture::generateName);
@@ -0,0 +1,118 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+
+#include <analyzer/common/common.h>
+#include <analyzer/simd/cpu.h>
+#include <analyzer/simd/energy.h>
+
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+constexpr auto MAX_BLOCKSIZE_SAMPLES = 32 * 32;
+
+uint32_t weightedCoeffSumReference(const int16_t *coeff,
+                                   const int16_t *weights,
+                                   unsigned stride,
+                                   unsigned size)
+{
+    uint32_t sum = 0;
+    for (unsigned y = 0; y < size; y++)
+        for (unsigned x = 0; x < size; x++)
+            sum += uint32_t((weights[y * stride + x] * std::abs(coeff[y * stride + x])) >> 8);
+    return sum;
+}
+
+} // namespace
+
+using BlockSize = unsigned;
+using Lowpass   = bool;
+using TestCase  = std::tuple<BlockSize, Lowpass>;
+
+class EnergyTestWeightedCoeffSumFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize = std::get<0>(info.param);
+        const auto lowpass   = std::get<1>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + (lowpass ? "_Lowpass" : "");
+    }
+};
+
+TEST_P(EnergyTestWeightedCoeffSumFixture, TestThatAllImplementationsProduceIdenticalResults)
+{
+    const auto blockSize = std::get<0>(GetParam());
+    const auto lowpass   = std::get<1>(GetParam());
+
+    // The lowpass sum of 16x16 and 32x32 blocks only covers the top left quadrant
+    const auto size = (lowpass && blockSize >= 16) ? blockSize / 2 : blockSize;
+
+    ALIGN_VAR_32(int16_t, coeffBuffer[MAX_BLOCKSIZE_SAMPLES]);
+    ALIGN_VAR_32(int16_t, weights[MAX_BLOCKSIZE_SAMPLES]);
+
+    std::default_random_engine randomEngine(42);
+    std::uniform_int_distribution<int> coeffDistribution(INT16_MIN, INT16_MAX);
+    std::uniform_int_distribution<int> weightDistribution(0, 255);
+    for (unsigned i = 0; i < blockSize * blockSize; i++)
+    {
+        coeffBuffer[i] = int16_t(coeffDistribution(randomEngine));
+        weights[i]     = int16_t(weightDistribution(randomEngine));
+    }
+    // The extreme values must not overflow
+    coeffBuffer[0] = INT16_MIN;
+    weights[0]     = 255;
+    coeffBuffer[1] = INT16_MAX;
+    weights[1]     = 255;
+
+    const auto expected = weightedCoeffSumReference(coeffBuffer, weights, blockSize, size);
+
+#if VCA_ARCH_X86
+    for (const auto cpuSimd : {CpuSimd::SSSE3, CpuSimd::AVX2, CpuSimd::AVX512})
+    {
+        if (!vca::isSimdSupported(cpuSimd))
+        {
+            std::cout << "Skipping testing of " << vca::CpuSimdMapper.getName(cpuSimd)
+                      << " because it is not supported on this platform.";
+            continue;
+        }
+
+        auto weightedCoeffSum = vca_weighted_coeff_sum_ssse3;
+        if (cpuSimd == CpuSimd::AVX2)
+            weightedCoeffSum = vca_weighted_coeff_sum_avx2;
+        else if (cpuSimd == CpuSimd::AVX512)
+            weightedCoeffSum = vca_weighted_coeff_sum_avx512;
+
+        const auto sum = weightedCoeffSum(coeffBuffer, weights, blockSize, size);
+        EXPECT_EQ(expected, sum) << "SIMD " << vca::CpuSimdMapper.getName(cpuSimd);
+    }
+#elif VCA_ARCH_ARM64
+    if (vca::isSimdSupported(CpuSimd::NEON))
+        EXPECT_EQ(expected, vca_weighted_coeff_sum_neon(coeffBuffer, weights, blockSize, size));
+#endif
+}
+
+INSTANTIATE_TEST_SUITE_P(EnergyTest,
+                         EnergyTestWeightedCoeffSumFixture,
+                         testing::Combine(testing::ValuesIn({BlockSize(8u),
+                                                             BlockSize(16u),
+                                                             BlockSize(32u)}),
+                                          testing::Bool()),
+                         &EnergyTestWeightedCoeffSumFixture::generateName);
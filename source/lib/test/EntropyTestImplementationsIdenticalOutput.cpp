@@ -0,0 +1,104 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/EntropyCalculation.h>
+#include <analyzer/common/common.h>
+#include <analyzer/simd/cpu.h>
+#include <test/common/functions.h>
+
+namespace {
+
+constexpr auto MAX_BLOCKSIZE_SAMPLES = 32 * 32;
+
+// The implementations sum up the probabilities in a different order
+constexpr auto ENTROPY_TOLERANCE = 1e-9;
+
+} // namespace
+
+using BlockSize     = unsigned;
+using BitDepth      = unsigned;
+using EnableLowpass = bool;
+using TestCase      = std::tuple<BlockSize, BitDepth, EnableLowpass>;
+
+class EntropyTestImplementationsIdenticalOutputFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize     = std::get<0>(info.param);
+        const auto bitDepth      = std::get<1>(info.param);
+        const auto enableLowpass = std::get<2>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + "_BitDepth" + std::to_string(bitDepth)
+               + (enableLowpass ? "_Lowpass" : "");
+    }
+};
+
+TEST_P(EntropyTestImplementationsIdenticalOutputFixture,
+       TestThatAllImplementationsProduceIdenticalResults)
+{
+    const auto param = GetParam();
+
+    const auto blockSize     = std::get<0>(param);
+    const auto bitDepth      = std::get<1>(param);
+    const auto enableLowpass = std::get<2>(param);
+
+    ALIGN_VAR_32(int16_t, pixelBuffer[MAX_BLOCKSIZE_SAMPLES]);
+    ALIGN_VAR_32(int16_t, flatPixelBuffer[MAX_BLOCKSIZE_SAMPLES]);
+
+    test::fillBlockWithRandomData(pixelBuffer, blockSize, bitDepth);
+
+    // Only a few distinct values so that most histogram bins are hit more than once
+    for (unsigned i = 0; i < blockSize * blockSize; i++)
+        flatPixelBuffer[i] = pixelBuffer[i] & 0x7;
+
+    for (const auto buffer : {pixelBuffer, flatPixelBuffer})
+    {
+        const auto entropyNative = vca::performEntropy(blockSize,
+                                                       bitDepth,
+                                                       buffer,
+                                                       CpuSimd::None,
+                                                       enableLowpass);
+
+        for (const auto cpuSimd : {CpuSimd::AVX2, CpuSimd::AVX512, CpuSimd::NEON})
+        {
+            if (!vca::isSimdSupported(cpuSimd))
+            {
+                std::cout << "Skipping testing of " << vca::CpuSimdMapper.getName(cpuSimd)
+                          << " because it is not supported on this platform.";
+                continue;
+            }
+
+            const auto entropy = vca::performEntropy(blockSize,
+                                                     bitDepth,
+                                                     buffer,
+                                                     cpuSimd,
+                                                     enableLowpass);
+            EXPECT_NEAR(entropyNative, entropy, ENTROPY_TOLERANCE);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    EntropyTest,
+    EntropyTestImplementationsIdenticalOutputFixture,
+    testing::Combine(testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                     testing::ValuesIn({BitDepth(8u), BitDepth(10u), BitDepth(12u)}),
+                     testing::Bool()),
+    &EntropyTestImplementationsIdenticalOutputFixture::generateName);
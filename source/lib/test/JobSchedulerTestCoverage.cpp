@@ -0,0 +1,136 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/JobScheduler.h>
+#include <analyzer/common/common.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr unsigned NR_FRAMES     = 20;
+constexpr unsigned NR_BLOCK_ROWS = 17;
+constexpr unsigned NR_WORKERS    = 4;
+
+} // namespace
+
+using BlockRowsPerJob = unsigned;
+
+class JobSchedulerTestCoverageFixture : public testing::TestWithParam<BlockRowsPerJob>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<BlockRowsPerJob> &info)
+    {
+        return "BlockRowsPerJob" + std::to_string(info.param);
+    }
+};
+
+TEST_P(JobSchedulerTestCoverageFixture, TestThatEachBlockRowIsProcessedExactlyOnce)
+{
+    vca::JobScheduler scheduler;
+    scheduler.setNumberOfWorkers(NR_WORKERS);
+    scheduler.setMaximumQueueSize(2);
+
+    std::mutex countMutex;
+    std::vector<std::vector<unsigned>> processedCount(NR_FRAMES,
+                                                      std::vector<unsigned>(NR_BLOCK_ROWS));
+    std::atomic<unsigned> nrBlockRowsPending{NR_FRAMES * NR_BLOCK_ROWS};
+
+    std::vector<std::thread> workers;
+    for (unsigned id = 0; id < NR_WORKERS; id++)
+        workers.emplace_back([&, id]() {
+            while (auto job = scheduler.waitAndPop(id))
+            {
+                const auto &range = job->macroblockRange;
+                EXPECT_LT(range.start, range.end);
+                EXPECT_LE(range.end - range.start, GetParam());
+                {
+                    std::unique_lock<std::mutex> lock(countMutex);
+                    for (auto row = range.start; row < range.end; row++)
+                        processedCount[job->jobID][row]++;
+                }
+                if (nrBlockRowsPending.fetch_sub(range.end - range.start)
+                    == range.end - range.start)
+                    scheduler.abort();
+            }
+        });
+
+    for (unsigned i = 0; i < NR_FRAMES; i++)
+    {
+        vca::Job job{};
+        job.jobID               = i;
+        job.macroblockRange.end = NR_BLOCK_ROWS;
+        scheduler.waitAndPush(job, GetParam());
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    for (const auto &frameCount : processedCount)
+        EXPECT_EQ(frameCount, std::vector<unsigned>(NR_BLOCK_ROWS, 1));
+}
+
+INSTANTIATE_TEST_SUITE_P(JobSchedulerTest,
+                         JobSchedulerTestCoverageFixture,
+                         testing::ValuesIn({BlockRowsPerJob(1),
+                                            BlockRowsPerJob(5),
+                                            BlockRowsPerJob(NR_BLOCK_ROWS)}),
+                         &JobSchedulerTestCoverageFixture::generateName);
+
+TEST(JobSchedulerTest, TestThatTheQueueIsNeverFullWhileBelowTheLimit)
+{
+    constexpr unsigned NR_PUSHED_FRAMES = 2000;
+
+    vca::JobScheduler scheduler;
+    scheduler.setNumberOfWorkers(NR_WORKERS);
+    scheduler.setMaximumQueueSize(NR_PUSHED_FRAMES + 1);
+
+    std::atomic<unsigned> nrFramesPending{NR_PUSHED_FRAMES};
+    std::atomic<unsigned> nrFullObservations{};
+
+    std::vector<std::thread> workers;
+    for (unsigned id = 0; id < NR_WORKERS; id++)
+        workers.emplace_back([&, id]() {
+            while (scheduler.waitAndPop(id))
+            {
+                // A frame taken before it was counted would wrap the counter
+                if (scheduler.full())
+                    nrFullObservations++;
+                if (nrFramesPending.fetch_sub(1) == 1)
+                    scheduler.abort();
+            }
+        });
+
+    for (unsigned i = 0; i < NR_PUSHED_FRAMES; i++)
+    {
+        vca::Job job{};
+        job.jobID               = i;
+        job.macroblockRange.end = 1;
+        scheduler.waitAndPush(job, 1);
+    }
+
+    for (auto &worker : workers)
+        worker.join();
+
+    EXPECT_EQ(nrFullObservations, 0u);
+}
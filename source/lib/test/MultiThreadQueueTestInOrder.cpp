@@ -0,0 +1,132 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/MultiThreadQueue.h>
+#include <analyzer/common/common.h>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr unsigned NR_ITEMS   = 200;
+constexpr unsigned NR_THREADS = 4;
+
+// Each thread pushes every NR_THREADS-th item with small random jumps in its order
+std::vector<std::vector<unsigned>> getItemsPerThread()
+{
+    std::vector<std::vector<unsigned>> itemsPerThread(NR_THREADS);
+    for (unsigned i = 0; i < NR_ITEMS; i++)
+        itemsPerThread[i % NR_THREADS].push_back(i);
+    std::default_random_engine randomEngine(42);
+    for (auto &threadItems : itemsPerThread)
+        for (size_t i = 0; i + 1 < threadItems.size(); i += 2)
+            if (randomEngine() % 2)
+                std::swap(threadItems[i], threadItems[i + 1]);
+    return itemsPerThread;
+}
+
+std::vector<std::thread> startPushing(vca::MultiThreadQueue<vca::SharedFrameResult *> &queue,
+                                      std::vector<vca::SharedFrameResult> &items,
+                                      const std::vector<std::vector<unsigned>> &itemsPerThread)
+{
+    std::vector<std::thread> threads;
+    for (const auto &threadItems : itemsPerThread)
+        threads.emplace_back([&queue, &items, &threadItems]() {
+            for (const auto i : threadItems)
+                queue.waitAndPushInOrder(&items[i], i);
+        });
+    return threads;
+}
+
+void expectItemsInOrder(vca::MultiThreadQueue<vca::SharedFrameResult *> &queue,
+                        std::vector<vca::SharedFrameResult> &items)
+{
+    for (unsigned i = 0; i < NR_ITEMS; i++)
+    {
+        const auto item = queue.waitAndPop();
+        ASSERT_TRUE(item);
+        EXPECT_EQ(*item, &items[i]);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+} // namespace
+
+using QueueSize = size_t;
+
+class MultiThreadQueueTestInOrderFixture : public testing::TestWithParam<QueueSize>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<QueueSize> &info)
+    {
+        return "QueueSize" + std::to_string(info.param);
+    }
+};
+
+TEST_P(MultiThreadQueueTestInOrderFixture, TestThatItemsPushedOutOfOrderArePoppedInOrder)
+{
+    std::vector<vca::SharedFrameResult> items(NR_ITEMS);
+    const auto itemsPerThread = getItemsPerThread();
+
+    vca::MultiThreadQueue<vca::SharedFrameResult *> queue;
+    queue.setMaximumQueueSize(GetParam());
+
+    auto threads = startPushing(queue, items, itemsPerThread);
+    expectItemsInOrder(queue, items);
+    for (auto &thread : threads)
+        thread.join();
+}
+
+TEST_P(MultiThreadQueueTestInOrderFixture, TestThatAnUnboundedQueuePopsAllItemsInOrder)
+{
+    std::vector<vca::SharedFrameResult> items(NR_ITEMS);
+    const auto itemsPerThread = getItemsPerThread();
+
+    vca::MultiThreadQueue<vca::SharedFrameResult *> queue;
+    queue.setUnboundedQueueSize(GetParam());
+
+    // Popping at the same time as the items move in and out of the overflow list
+    auto threads = startPushing(queue, items, itemsPerThread);
+    expectItemsInOrder(queue, items);
+    for (auto &thread : threads)
+        thread.join();
+}
+
+TEST_P(MultiThreadQueueTestInOrderFixture, TestThatPushingToAnUnboundedQueueDoesNotWait)
+{
+    std::vector<vca::SharedFrameResult> items(NR_ITEMS);
+    const auto itemsPerThread = getItemsPerThread();
+
+    vca::MultiThreadQueue<vca::SharedFrameResult *> queue;
+    queue.setUnboundedQueueSize(GetParam());
+
+    auto threads = startPushing(queue, items, itemsPerThread);
+    for (auto &thread : threads)
+        thread.join();
+    expectItemsInOrder(queue, items);
+}
+
+INSTANTIATE_TEST_SUITE_P(MultiThreadQueueTest,
+                         MultiThreadQueueTestInOrderFixture,
+                         testing::ValuesIn({QueueSize(8), QueueSize(NR_ITEMS)}),
+                         &MultiThreadQueueTestInOrderFixture::generateName);
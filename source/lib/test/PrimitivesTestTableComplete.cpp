@@ -0,0 +1,82 @@
+/* Copyright (C) 2024 Christian Doppler Laboratory ATHENA
+ *
+ * Authors: Christian Feldmann <christian.feldmann@bitmovin.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <analyzer/Primitives.h>
+#include <analyzer/common/common.h>
+
+#include <stdexcept>
+
+using BlockSize = unsigned;
+using BitDepth  = unsigned;
+using TestCase  = std::tuple<BlockSize, BitDepth, CpuSimd>;
+
+class PrimitivesTestTableCompleteFixture : public testing::TestWithParam<TestCase>
+{
+public:
+    static std::string generateName(const ::testing::TestParamInfo<TestCase> &info)
+    {
+        const auto blockSize = std::get<0>(info.param);
+        const auto bitDepth  = std::get<1>(info.param);
+        const auto cpuSimd   = std::get<2>(info.param);
+        return "BlockSize" + std::to_string(blockSize) + "_BitDepth" + std::to_string(bitDepth)
+               + "_" + vca::CpuSimdMapper.getName(cpuSimd);
+    }
+};
+
+// Every SIMD level must leave a kernel in each entry of the table. The table is set up for all
+// levels because no kernel is called.
+TEST_P(PrimitivesTestTableCompleteFixture, TestThatAllKernelsAreSet)
+{
+    const auto blockSize = std::get<0>(GetParam());
+    const auto bitDepth  = std::get<1>(GetParam());
+    const auto cpuSimd   = std::get<2>(GetParam());
+
+    const auto primitives = vca::setupPrimitives(blockSize, bitDepth, cpuSimd);
+    EXPECT_NE(primitives.dct, nullptr);
+    EXPECT_NE(primitives.dctFromPlane, nullptr);
+    EXPECT_EQ(primitives.lowpassDCT != nullptr, blockSize >= 16);
+    EXPECT_NE(primitives.downscale, nullptr);
+    EXPECT_NE(primitives.downscaleFromPlane, nullptr);
+    EXPECT_NE(primitives.copyBlock, nullptr);
+    EXPECT_NE(primitives.weightedCoeffSum, nullptr);
+    EXPECT_NE(primitives.entropy, nullptr);
+    EXPECT_NE(primitives.edgeCount, nullptr);
+    EXPECT_NE(primitives.computeFeatures, nullptr);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PrimitivesTest,
+    PrimitivesTestTableCompleteFixture,
+    testing::Combine(testing::ValuesIn({BlockSize(8u), BlockSize(16u), BlockSize(32u)}),
+                     testing::ValuesIn({BitDepth(8u), BitDepth(10u), BitDepth(12u)}),
+                     testing::ValuesIn({CpuSimd::None,
+                                        CpuSimd::SSE2,
+                                        CpuSimd::SSSE3,
+                                        CpuSimd::SSE4,
+                                        CpuSimd::AVX2,
+                                        CpuSimd::AVX512,
+                                        CpuSimd::NEON})),
+    &PrimitivesTestTableCompleteFixture::generateName);
+
+TEST(PrimitivesTest, TestThatInvalidParametersThrow)
+{
+    EXPECT_THROW(vca::setupPrimitives(4, 8, CpuSimd::None), std::invalid_argument);
+    EXPECT_THROW(vca::setupPrimitives(8, 9, CpuSimd::None), std::invalid_argument);
+}
@@ -18,6 +18,8 @@
 
 #include "functions.h"
 
+#include <analyzer/common/common.h>
+
 #include <random>
 
 namespace test {
@@ -36,4 +38,59 @@ void fillBlockWithRandomData(int16_t *data, const unsigned blockSize, const unsi
         data[i] = int16_t(uniform_dist(randomEngine));
 }
 
-} // namespace test
\ No newline at end of file
+TestFrame::TestFrame(unsigned width, unsigned height, unsigned bitDepth)
+{
+    const auto bytesPerPixel = bitDepth > 8 ? 2u : 1u;
+    const auto lumaSize      = width * height;
+    const auto chromaSize    = lumaSize / 4;
+    this->data.resize((lumaSize + 2 * chromaSize) * bytesPerPixel);
+
+    static std::default_random_engine randomEngine(42);
+    std::uniform_int_distribution<unsigned> uniform_dist(0, (1u << bitDepth) - 1);
+    if (bitDepth > 8)
+    {
+        auto samples = reinterpret_cast<uint16_t *>(this->data.data());
+        for (size_t i = 0; i < this->data.size() / 2; i++)
+            samples[i] = uint16_t(uniform_dist(randomEngine));
+    }
+    else
+    {
+        for (auto &sample : this->data)
+            sample = uint8_t(uniform_dist(randomEngine));
+    }
+
+    this->frame.info.width      = width;
+    this->frame.info.height     = height;
+    this->frame.info.bitDepth   = bitDepth;
+    this->frame.info.colorspace = vca_colorSpace::YUV420;
+    this->frame.planes[0]       = this->data.data();
+    this->frame.planes[1]       = this->data.data() + lumaSize * bytesPerPixel;
+    this->frame.planes[2]       = this->frame.planes[1] + chromaSize * bytesPerPixel;
+    this->frame.stride[0]       = int(width * bytesPerPixel);
+    this->frame.stride[1]       = int(width / 2 * bytesPerPixel);
+    this->frame.stride[2]       = int(width / 2 * bytesPerPixel);
+    this->frame.height[0]       = int(height);
+    this->frame.height[1]       = int(height / 2);
+    this->frame.height[2]       = int(height / 2);
+}
+
+TestResult::TestResult(const vca_frame_info &info, unsigned blockSize)
+{
+    const auto [widthInBlocks, heightInBlocks] = vca::getFrameSizeInBlocks(blockSize, info);
+    this->nrBlocks = size_t(widthInBlocks) * heightInBlocks;
+    this->energy.resize(this->nrBlocks);
+    this->energyU.resize(this->nrBlocks);
+    this->energyDiff.resize(this->nrBlocks);
+    this->entropy.resize(this->nrBlocks);
+    this->entropyV.resize(this->nrBlocks);
+    this->edgeDensity.resize(this->nrBlocks);
+
+    this->result.energyPerBlock      = this->energy.data();
+    this->result.energyUPerBlock     = this->energyU.data();
+    this->result.energyDiffPerBlock  = this->energyDiff.data();
+    this->result.entropyPerBlock     = this->entropy.data();
+    this->result.entropyVPerBlock    = this->entropyV.data();
+    this->result.edgeDensityPerBlock = this->edgeDensity.data();
+}
+
+} // namespace test
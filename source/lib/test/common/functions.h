@@ -22,9 +22,38 @@
 #include <vcaLib.h>
 
 #include <stdint.h>
+#include <vector>
 
 namespace test {
 
+// The frame size of the analyzer tests. Not a multiple of any block size.
+constexpr unsigned FRAME_WIDTH  = 360;
+constexpr unsigned FRAME_HEIGHT = 202;
+
 void fillBlockWithRandomData(int16_t *data, const unsigned blockSize, const unsigned bitDepth);
 
+// A YUV 4:2:0 frame filled with random samples
+struct TestFrame
+{
+    TestFrame(unsigned width, unsigned height, unsigned bitDepth);
+
+    std::vector<uint8_t> data;
+    vca_frame frame;
+};
+
+// A result with buffers for the per block values of a frame of the given size
+struct TestResult
+{
+    TestResult(const vca_frame_info &info, unsigned blockSize);
+
+    size_t nrBlocks{};
+    std::vector<uint32_t> energy;
+    std::vector<uint32_t> energyU;
+    std::vector<uint32_t> energyDiff;
+    std::vector<double> entropy;
+    std::vector<double> entropyV;
+    std::vector<double> edgeDensity;
+    vca_frame_results result;
+};
+
 } // namespace test
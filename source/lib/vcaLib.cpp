@@ -19,12 +19,31 @@
  *****************************************************************************/
 
 #include <analyzer/Analyzer.h>
+#include <analyzer/Executor.h>
 #include <analyzer/ShotDetection.h>
 #include <vcaLib.h>
 
 #define XSTR(x) STR(x)
 #define STR(x) #x
 
+DLL_PUBLIC vca_executor *vca_executor_create(unsigned nrThreads)
+{
+    try
+    {
+        return new vca::Executor(nrThreads);
+    }
+    catch (const std::exception &)
+    {
+        return nullptr;
+    }
+}
+
+DLL_PUBLIC void vca_executor_destroy(vca_executor *executor)
+{
+    auto sharedExecutor = (vca::Executor *) executor;
+    delete sharedExecutor;
+}
+
 DLL_PUBLIC vca_analyzer *vca_analyzer_open(vca_param param)
 {
     try
@@ -50,6 +69,15 @@ DLL_PUBLIC vca_result vca_analyzer_push(vca_analyzer *enc, vca_frame *frame)
     return analyzer->pushFrame(frame);
 }
 
+DLL_PUBLIC vca_result vca_analyzer_try_push(vca_analyzer *enc, vca_frame *frame)
+{
+    if (enc == nullptr)
+        return vca_result::VCA_ERROR;
+
+    auto analyzer = (vca::Analyzer *) enc;
+    return analyzer->tryPushFrame(frame);
+}
+
 DLL_PUBLIC bool vca_result_available(vca_analyzer *enc)
 {
     auto analyzer = (vca::Analyzer *) (enc);
@@ -68,6 +96,26 @@ DLL_PUBLIC vca_result vca_analyzer_pull_frame_result(vca_analyzer *enc, vca_fram
     return analyzer->pullResult(result);
 }
 
+DLL_PUBLIC vca_result vca_analyzer_pull_frame_result_ref(vca_analyzer *enc,
+                                                         const vca_frame_results **result)
+{
+    if (enc == nullptr || result == nullptr)
+        return vca_result::VCA_ERROR;
+
+    auto analyzer = (vca::Analyzer *) (enc);
+    return analyzer->pullResultRef(result);
+}
+
+DLL_PUBLIC vca_result vca_analyzer_release_result(vca_analyzer *enc,
+                                                  const vca_frame_results *result)
+{
+    if (enc == nullptr || result == nullptr)
+        return vca_result::VCA_ERROR;
+
+    auto analyzer = (vca::Analyzer *) (enc);
+    return analyzer->releaseResult(result);
+}
+
 DLL_PUBLIC void vca_analyzer_close(vca_analyzer *enc)
 {
     auto analyzer = (vca::Analyzer *) enc;
@@ -37,6 +37,10 @@ extern "C" {
  *      opaque handler for analyzer */
 typedef void vca_analyzer;
 
+/* vca_executor:
+ *      opaque handler for a thread pool that is shared by several analyzers */
+typedef void vca_executor;
+
 /* vca_picyuv:
  *      opaque handler for PicYuv */
 typedef struct vca_picyuv vca_picyuv;
@@ -56,7 +60,9 @@ enum class CpuSimd
     SSE2,
     SSSE3,
     SSE4,
-    AVX2
+    AVX2,
+    AVX512,
+    NEON
 };
 
 enum class vca_colorSpace
@@ -169,15 +175,44 @@ struct vca_param
     // Size (width/height) of the analysis block. Must be 8, 16 or 32.
     unsigned blockSize{32};
 
+    // Number of worker threads. 0 means autodetect.
     unsigned nrFrameThreads{0};
+    // If set, the analyzer uses the threads of this executor (see vca_executor_create) instead of
+    // starting its own. nrFrameThreads is ignored then.
+    vca_executor *executor{};
+    // Number of slices (ranges of block rows) each frame is split into. The slices of a frame
+    // are analyzed in parallel by the worker threads, which reduces the latency of a single
+    // frame. Idle threads steal slices from other frames. 0 means one slice per thread and 1
+    // disables splitting.
     unsigned nrSliceThreads{0};
 
+    // Maximum number of pushed frames that wait for a worker thread. Pushing more frames blocks
+    // or returns VCA_BUSY. 0 means autodetect (at least 5 and one per worker thread).
+    unsigned jobQueueSize{0};
+    // Maximum number of analyzed frames that wait to be pulled. Once it is full, the analysis
+    // stops until results are pulled. It is raised to at least jobQueueSize plus the number of
+    // worker threads. 0 means no limit: all results are kept until they are pulled.
+    unsigned resultQueueSize{0};
+
     CpuSimd cpuSimd{CpuSimd::Autodetect};
 
     void (*logFunction)(void *, LogLevel, const char *){};
     void *logFunctionPrivateData{};
 };
 
+/* Create a pool of nrThreads worker threads (0 for one per CPU core) that several analyzers can
+ * share by setting vca_param::executor. This bounds the number of threads if many streams are
+ * analyzed at the same time. The threads take turns between the analyzers that have frames
+ * pending, so every stream gets the same share. If the resultQueueSize of an analyzer is limited,
+ * its results must be pulled, otherwise its frames block threads that the other analyzers need.
+ * Returns nullptr on error.
+ */
+DLL_PUBLIC vca_executor *vca_executor_create(unsigned nrThreads);
+
+/* Stop the threads of the executor. All analyzers using it must be closed before.
+ */
+DLL_PUBLIC void vca_executor_destroy(vca_executor *executor);
+
 /* Create a new analyzer or nullptr if the config is invalid.
  */
 DLL_PUBLIC vca_analyzer *vca_analyzer_open(vca_param cfg);
@@ -185,7 +220,8 @@ DLL_PUBLIC vca_analyzer *vca_analyzer_open(vca_param cfg);
 typedef enum
 {
     VCA_OK = 0,
-    VCA_ERROR
+    VCA_ERROR,
+    VCA_BUSY
 } vca_result;
 
 /* Push a frame to the analyzer and start the analysis.
@@ -195,9 +231,16 @@ typedef enum
  * library will not use pointers anymore.
  * This may block until there is a slot available to work on. The number of
  * frames that will be processed in parallel can be set using nrFrameThreads.
+ * If resultQueueSize is set, only that many results are buffered. Pull results before pushing
+ * more frames than that.
  */
 DLL_PUBLIC vca_result vca_analyzer_push(vca_analyzer *enc, vca_frame *pic_in);
 
+/* Like vca_analyzer_push but never blocks. If jobQueueSize frames are already waiting for a
+ * worker thread, the frame is not pushed and VCA_BUSY is returned. Push it again later.
+ */
+DLL_PUBLIC vca_result vca_analyzer_try_push(vca_analyzer *enc, vca_frame *pic_in);
+
 /* Check if a result is available to pull.
  */
 DLL_PUBLIC bool vca_result_available(vca_analyzer *enc);
@@ -207,6 +250,21 @@ DLL_PUBLIC bool vca_result_available(vca_analyzer *enc);
  */
 DLL_PUBLIC vca_result vca_analyzer_pull_frame_result(vca_analyzer *enc, vca_frame_results *result);
 
+/* Pull a result from the analyzer without copying the per block values. On success result
+ * points to a read only view into the internal buffers of the library. The per block pointers
+ * of disabled features are nullptr. The view stays valid until it is given back using
+ * vca_analyzer_release_result, which must be called exactly once for every pulled result and
+ * before the analyzer is closed. This may block like vca_analyzer_pull_frame_result.
+ */
+DLL_PUBLIC vca_result vca_analyzer_pull_frame_result_ref(vca_analyzer *enc,
+                                                         const vca_frame_results **result);
+
+/* Give a result that was pulled using vca_analyzer_pull_frame_result_ref back to the analyzer.
+ * Returns VCA_ERROR for results that are unknown or were already given back.
+ */
+DLL_PUBLIC vca_result vca_analyzer_release_result(vca_analyzer *enc,
+                                                  const vca_frame_results *result);
+
 DLL_PUBLIC void vca_analyzer_close(vca_analyzer *enc);
 
 struct vca_shot_detection_param